@@ -4,6 +4,8 @@ set -euo pipefail
 # OKSI Software Licensing Installer
 # - Installs Python licensing app into a self-contained venv under /opt/oksi/sw-licensing
 # - Installs native fingerprint binary to /usr/local/bin/oksi_fingerprint
+#   and its library to /usr/local/lib/liboksi_fingerprint.so.1 (loaded
+#   in-process by fingerprint.py via ctypes)
 # - Does not touch global Python modules
 #
 # Usage (remote):
@@ -14,14 +16,14 @@ set -euo pipefail
 #   OKSI_PREFIX          Install prefix for binaries (default: /usr/local)
 #   OKSI_ROOT            Install root for app (default: /opt/oksi)
 #   OKSI_PYTHON          Python interpreter to use for venv (default: python3)
-#   OKSI_SKIP_FP         If set to 1, skip installing oksi_fingerprint
+#   OKSI_SKIP_FP         If set to 1, skip installing oksi_fingerprint and its library
 #
 # Optional flags (when running locally):
 #   --base <url>         Override download base URL
 #   --prefix <dir>       Override /usr/local
 #   --root <dir>         Override /opt/oksi
 #   --python <path>      Override python3
-#   --skip-fingerprint   Do not install fingerprint binary
+#   --skip-fingerprint   Do not install fingerprint binary or library
 
 umask 022
 
@@ -103,6 +105,7 @@ APP_DIR="$OKSI_ROOT/sw-licensing"
 VENVDIR="$APP_DIR/venv"
 MANDIR="$APP_DIR"
 BIN_DIR="$PREFIX/bin"
+LIB_DIR="$PREFIX/lib"
 mkdir -p "$APP_DIR" "$BIN_DIR"
 
 log "Installing to root=$OKSI_ROOT prefix=$PREFIX (os=$OS arch=$ARCH)"
@@ -163,6 +166,19 @@ if [[ "$INSTALL_FP" -eq 1 ]]; then
   else
     err "could not download $FP_URL — continuing without native helper (Python fallback will be used)"
   fi
+
+  # Shared library in ../lib of the helper, where fingerprint.py looks for it
+  LIB_URL="$BASE_URL/liboksi_fingerprint-${OS}-${ARCH}.so.1"
+  LIB_DST="$LIB_DIR/liboksi_fingerprint.so.1"
+  log "Downloading fingerprint library..."
+  if download "$LIB_URL" "$TMPDIR/liboksi_fingerprint.so.1"; then
+    mkdir -p "$LIB_DIR"
+    install -m 0644 "$TMPDIR/liboksi_fingerprint.so.1" "$LIB_DST"
+    log "Installed $LIB_DST"
+    echo "$LIB_DST" >> "$MANIFEST_PATH"
+  else
+    err "could not download $LIB_URL — continuing without in-process library (helper/Python fallback will be used)"
+  fi
 fi
 
 # 5) Write uninstall script
@@ -194,4 +210,7 @@ log "  - oksi-sw-license (Python CLI)"
 if [[ -x "$BIN_DIR/oksi_fingerprint" ]]; then
   log "  - oksi_fingerprint (native helper)"
 fi
+if [[ -f "$LIB_DIR/liboksi_fingerprint.so.1" ]]; then
+  log "  - liboksi_fingerprint.so.1 (in-process fingerprint library)"
+fi
 log "To uninstall: sudo $UNINSTALL_SHIM"
@@ -3,7 +3,13 @@ set -euo pipefail
 
 # Build fingerprint helper for one or more targets and stage into dist/bin
 # Cross-compilation is supported for Linux targets when the appropriate
-# cross toolchains are installed (e.g., aarch64-linux-gnu-g++, x86_64-linux-gnu-g++).
+# cross toolchains are installed (e.g., aarch64-linux-gnu-g++/-gcc,
+# x86_64-linux-gnu-g++/-gcc).
+#
+# Outputs per target:
+#   dist/bin/oksi_fingerprint-<os>-<arch>           CLI helper
+#   dist/bin/liboksi_fingerprint-<os>-<arch>.so.1   C ABI library (ctypes path
+#                                                   in fingerprint.py)
 #
 # Usage:
 #   # Build for current host only
@@ -35,7 +41,8 @@ build_one() {
   local os="$1" arch="$2"
   local build_dir="$ROOT_DIR/build/fingerprint-$os-$arch"
   local cflags="-O3"
-  local cmake_args=( -S "$ROOT_DIR/src/fingerprint" -B "$build_dir" -DCMAKE_BUILD_TYPE=Release )
+  # Tests are not built for distribution (they could not run on a cross target)
+  local cmake_args=( -S "$ROOT_DIR/src/fingerprint" -B "$build_dir" -DCMAKE_BUILD_TYPE=Release -DBUILD_TESTING=OFF )
 
   case "$os" in
     linux)
@@ -45,12 +52,13 @@ build_one() {
           if [[ "$host_os-$host_arch" == "linux-amd64" ]]; then
             : # native build, no extra toolchain args
           else
-            if command -v x86_64-linux-gnu-g++ >/dev/null 2>&1; then
+            if command -v x86_64-linux-gnu-g++ >/dev/null 2>&1 && command -v x86_64-linux-gnu-gcc >/dev/null 2>&1; then
               cmake_args+=( -DCMAKE_SYSTEM_NAME=Linux \
                             -DCMAKE_SYSTEM_PROCESSOR=x86_64 \
+                            -DCMAKE_C_COMPILER=x86_64-linux-gnu-gcc \
                             -DCMAKE_CXX_COMPILER=x86_64-linux-gnu-g++ )
             else
-              echo "[cross] missing x86_64-linux-gnu-g++ toolchain for linux-amd64" >&2; return 1
+              echo "[cross] missing x86_64-linux-gnu-g++/gcc toolchain for linux-amd64" >&2; return 1
             fi
           fi
           ;;
@@ -58,12 +66,13 @@ build_one() {
           if [[ "$host_os-$host_arch" == "linux-arm64" ]]; then
             :
           else
-            if command -v aarch64-linux-gnu-g++ >/dev/null 2>&1; then
+            if command -v aarch64-linux-gnu-g++ >/dev/null 2>&1 && command -v aarch64-linux-gnu-gcc >/dev/null 2>&1; then
               cmake_args+=( -DCMAKE_SYSTEM_NAME=Linux \
                             -DCMAKE_SYSTEM_PROCESSOR=aarch64 \
+                            -DCMAKE_C_COMPILER=aarch64-linux-gnu-gcc \
                             -DCMAKE_CXX_COMPILER=aarch64-linux-gnu-g++ )
             else
-              echo "[cross] missing aarch64-linux-gnu-g++ toolchain for linux-arm64" >&2; return 1
+              echo "[cross] missing aarch64-linux-gnu-g++/gcc toolchain for linux-arm64" >&2; return 1
             fi
           fi
           ;;
@@ -85,6 +94,15 @@ build_one() {
   cp "$bin_path" "$out"
   chmod 0755 "$out"
   echo "Wrote $out"
+
+  local lib_path="$build_dir/lib/liboksi_fingerprint.so.1"
+  if [[ ! -e "$lib_path" ]]; then
+    echo "Build did not produce $lib_path" >&2; return 1
+  fi
+  local lib_out="$OUT_DIR/liboksi_fingerprint-$os-$arch.so.1"
+  cp -L "$lib_path" "$lib_out"
+  chmod 0644 "$lib_out"
+  echo "Wrote $lib_out"
 }
 
 status=0
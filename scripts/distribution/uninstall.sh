@@ -31,6 +31,7 @@ fi
 rm -f \
   /usr/local/bin/oksi-sw-license \
   /usr/local/bin/oksi_fingerprint \
+  /usr/local/lib/liboksi_fingerprint.so.1 \
   /usr/local/bin/oksi-sw-license-uninstall || true
 
 rm -rf "$APP_DIR" || true
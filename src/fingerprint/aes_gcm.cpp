@@ -0,0 +1,163 @@
+// AES-256-GCM Decryption (C++)
+// ---------------------------------
+// Purpose:
+//   Authenticated decryption of Keygen "aes-256-gcm" machine-file payloads
+//   for oksi_verify (NIST SP 800-38D, 96-bit IV, 128-bit tag, no AAD).
+//
+// Implementation notes:
+//   Byte-oriented AES-256 with an S-box table and a bitwise GHASH multiply.
+//   Payloads are a few KiB, so clarity wins over speed here. The tag is
+//   checked (constant-time compare) before any plaintext is released.
+
+#include "crypto.hpp"
+
+#include <cstring>
+
+namespace oksi {
+
+namespace {
+
+const uint8_t SBOX[256] = {
+    0x63,0x7c,0x77,0x7b,0xf2,0x6b,0x6f,0xc5,0x30,0x01,0x67,0x2b,0xfe,0xd7,0xab,0x76,
+    0xca,0x82,0xc9,0x7d,0xfa,0x59,0x47,0xf0,0xad,0xd4,0xa2,0xaf,0x9c,0xa4,0x72,0xc0,
+    0xb7,0xfd,0x93,0x26,0x36,0x3f,0xf7,0xcc,0x34,0xa5,0xe5,0xf1,0x71,0xd8,0x31,0x15,
+    0x04,0xc7,0x23,0xc3,0x18,0x96,0x05,0x9a,0x07,0x12,0x80,0xe2,0xeb,0x27,0xb2,0x75,
+    0x09,0x83,0x2c,0x1a,0x1b,0x6e,0x5a,0xa0,0x52,0x3b,0xd6,0xb3,0x29,0xe3,0x2f,0x84,
+    0x53,0xd1,0x00,0xed,0x20,0xfc,0xb1,0x5b,0x6a,0xcb,0xbe,0x39,0x4a,0x4c,0x58,0xcf,
+    0xd0,0xef,0xaa,0xfb,0x43,0x4d,0x33,0x85,0x45,0xf9,0x02,0x7f,0x50,0x3c,0x9f,0xa8,
+    0x51,0xa3,0x40,0x8f,0x92,0x9d,0x38,0xf5,0xbc,0xb6,0xda,0x21,0x10,0xff,0xf3,0xd2,
+    0xcd,0x0c,0x13,0xec,0x5f,0x97,0x44,0x17,0xc4,0xa7,0x7e,0x3d,0x64,0x5d,0x19,0x73,
+    0x60,0x81,0x4f,0xdc,0x22,0x2a,0x90,0x88,0x46,0xee,0xb8,0x14,0xde,0x5e,0x0b,0xdb,
+    0xe0,0x32,0x3a,0x0a,0x49,0x06,0x24,0x5c,0xc2,0xd3,0xac,0x62,0x91,0x95,0xe4,0x79,
+    0xe7,0xc8,0x37,0x6d,0x8d,0xd5,0x4e,0xa9,0x6c,0x56,0xf4,0xea,0x65,0x7a,0xae,0x08,
+    0xba,0x78,0x25,0x2e,0x1c,0xa6,0xb4,0xc6,0xe8,0xdd,0x74,0x1f,0x4b,0xbd,0x8b,0x8a,
+    0x70,0x3e,0xb5,0x66,0x48,0x03,0xf6,0x0e,0x61,0x35,0x57,0xb9,0x86,0xc1,0x1d,0x9e,
+    0xe1,0xf8,0x98,0x11,0x69,0xd9,0x8e,0x94,0x9b,0x1e,0x87,0xe9,0xce,0x55,0x28,0xdf,
+    0x8c,0xa1,0x89,0x0d,0xbf,0xe6,0x42,0x68,0x41,0x99,0x2d,0x0f,0xb0,0x54,0xbb,0x16
+};
+
+inline uint8_t xtime(uint8_t x) { return static_cast<uint8_t>((x << 1) ^ ((x >> 7) * 0x1b)); }
+
+struct Aes256 {
+    uint8_t rk[15][16];
+
+    explicit Aes256(const uint8_t key[32]) {
+        uint8_t w[240];
+        std::memcpy(w, key, 32);
+        uint8_t rcon = 1;
+        for (int i = 32; i < 240; i += 4) {
+            uint8_t t[4] = {w[i-4], w[i-3], w[i-2], w[i-1]};
+            if (i % 32 == 0) {
+                const uint8_t t0 = t[0];
+                t[0] = SBOX[t[1]] ^ rcon;
+                t[1] = SBOX[t[2]];
+                t[2] = SBOX[t[3]];
+                t[3] = SBOX[t0];
+                rcon = xtime(rcon);
+            } else if (i % 32 == 16) {
+                for (int j = 0; j < 4; ++j) t[j] = SBOX[t[j]];
+            }
+            for (int j = 0; j < 4; ++j) w[i + j] = w[i - 32 + j] ^ t[j];
+        }
+        std::memcpy(rk, w, sizeof rk);
+    }
+
+    void encrypt(const uint8_t in[16], uint8_t out[16]) const {
+        uint8_t s[16];
+        for (int i = 0; i < 16; ++i) s[i] = in[i] ^ rk[0][i];
+        for (int r = 1; r <= 14; ++r) {
+            // SubBytes + ShiftRows (column-major state)
+            uint8_t t[16];
+            for (int c = 0; c < 4; ++c)
+                for (int row = 0; row < 4; ++row) t[4 * c + row] = SBOX[s[4 * ((c + row) & 3) + row]];
+            // MixColumns (skipped in the last round)
+            if (r != 14) {
+                for (int c = 0; c < 4; ++c) {
+                    uint8_t *col = t + 4 * c;
+                    const uint8_t a0 = col[0], a1 = col[1], a2 = col[2], a3 = col[3];
+                    const uint8_t all = a0 ^ a1 ^ a2 ^ a3;
+                    col[0] ^= all ^ xtime(a0 ^ a1);
+                    col[1] ^= all ^ xtime(a1 ^ a2);
+                    col[2] ^= all ^ xtime(a2 ^ a3);
+                    col[3] ^= all ^ xtime(a3 ^ a0);
+                }
+            }
+            for (int i = 0; i < 16; ++i) s[i] = t[i] ^ rk[r][i];
+        }
+        std::memcpy(out, s, 16);
+    }
+};
+
+// GF(2^128) multiply in GCM bit order: x = x * h.
+void gf128_mul(uint8_t x[16], const uint8_t h[16]) {
+    uint8_t z[16] = {0};
+    uint8_t v[16];
+    std::memcpy(v, h, 16);
+    for (int i = 0; i < 128; ++i) {
+        if ((x[i >> 3] >> (7 - (i & 7))) & 1)
+            for (int j = 0; j < 16; ++j) z[j] ^= v[j];
+        const uint8_t lsb = v[15] & 1;
+        for (int j = 15; j > 0; --j) v[j] = static_cast<uint8_t>((v[j] >> 1) | (v[j-1] << 7));
+        v[0] >>= 1;
+        if (lsb) v[0] ^= 0xe1;
+    }
+    std::memcpy(x, z, 16);
+}
+
+void ghash_update(uint8_t y[16], const uint8_t h[16], const uint8_t *data, size_t len) {
+    while (len) {
+        const size_t n = len < 16 ? len : 16;
+        for (size_t i = 0; i < n; ++i) y[i] ^= data[i];
+        gf128_mul(y, h);
+        data += n;
+        len -= n;
+    }
+}
+
+void ctr_inc(uint8_t ctr[16]) {
+    for (int i = 15; i >= 12; --i)
+        if (++ctr[i]) break;
+}
+
+} // namespace
+
+bool aes256_gcm_decrypt(const uint8_t key[32], const uint8_t iv[12], const uint8_t *ct, size_t len,
+                        const uint8_t tag[16], std::vector<uint8_t> &out) {
+    out.clear();
+    const Aes256 aes(key);
+
+    uint8_t h[16] = {0};
+    aes.encrypt(h, h);
+
+    // J0 = IV || 0^31 || 1
+    uint8_t j0[16] = {0};
+    std::memcpy(j0, iv, 12);
+    j0[15] = 1;
+
+    // S = GHASH(C || len(A)=0 || len(C))
+    uint8_t s[16] = {0};
+    ghash_update(s, h, ct, len);
+    uint8_t lens[16] = {0};
+    const uint64_t bits = static_cast<uint64_t>(len) * 8;
+    for (int i = 0; i < 8; ++i) lens[15 - i] = static_cast<uint8_t>(bits >> (8 * i));
+    ghash_update(s, h, lens, 16);
+
+    uint8_t ek[16];
+    aes.encrypt(j0, ek);
+    uint8_t diff = 0;
+    for (int i = 0; i < 16; ++i) diff |= (s[i] ^ ek[i]) ^ tag[i];
+    if (diff != 0) return false;
+
+    out.resize(len);
+    uint8_t ctr[16];
+    std::memcpy(ctr, j0, 16);
+    for (size_t off = 0; off < len; off += 16) {
+        ctr_inc(ctr);
+        aes.encrypt(ctr, ek);
+        const size_t n = len - off < 16 ? len - off : 16;
+        for (size_t i = 0; i < n; ++i) out[off + i] = ct[off + i] ^ ek[i];
+    }
+    return true;
+}
+
+} // namespace oksi
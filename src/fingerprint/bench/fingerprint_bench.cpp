@@ -0,0 +1,397 @@
+// Fingerprint Benchmarks (C++)
+// ---------------------------------
+// Purpose:
+//   Self-contained micro/macro benchmark suite for the fingerprint helper's
+//   hot paths, meant to catch regressions before they reach the activation
+//   path. Each case runs repeatedly for a minimum wall time; results are
+//   printed as a table and optionally written as JSON for diffing between
+//   releases.
+//
+// Cases:
+//   sha256/<size>   SHA256::update + digest on 32 B .. 4 KiB inputs
+//   update/<size>   SHA256::update + digest throughput on 1 KiB, 1 MiB and
+//                   1 GiB inputs (the 1 GiB case streams a 1 MiB buffer 1024
+//                   times); reports bytes per second
+//   many/<engine>   sha256_many over 64k fingerprint-sized messages, for the
+//                   single-stream baseline and every multi-lane engine this
+//                   CPU supports; reports messages per second
+//   base64/<size>   base64_urlsafe_nopad on a 32 B digest and a 4 KiB buffer
+//   read_file       oksi::read_file latency on a machine-id sized file
+//   fingerprint     compute_fingerprint (in-process, no I/O)
+//   fingerprint/prefix
+//                   FingerprintPrefix::derive with the machine-id prefix
+//                   hashed once, as the daemon does on cache misses
+//   cold_start      spawn + wait of the oksi_fingerprint executable
+//   serve_roundtrip one "GET <salt>" round trip to a private `--serve` daemon
+//                   (Linux)
+//
+// JSON:
+//   Uses the Google Benchmark result layout ("context" + "benchmarks" with
+//   name, iterations, real_time, cpu_time, time_unit and
+//   bytes/items_per_second), so its tools/compare.py can diff two runs
+//   directly. cpu_time is this process's CPU time (std::clock), so it excludes
+//   the child processes of cold_start and the daemon of serve_roundtrip.
+//
+// Usage:
+//   oksi_fingerprint_bench [--filter <substring>] [--min-time <seconds>]
+//                          [--json <path>|-] [--exe <oksi_fingerprint path>]
+
+#include "fingerprint_core.hpp"
+#include "sha256.hpp"
+#include "sha256_multi.hpp"
+
+#include <array>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <ctime>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <random>
+#include <string>
+#include <vector>
+
+#if !defined(_WIN32)
+#include <fcntl.h>
+#include <csignal>
+#include <spawn.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+extern char **environ;
+#endif
+
+namespace {
+
+struct Options {
+    std::string filter;
+    double min_time = 0.5;
+    std::string json;
+    std::string exe;
+};
+
+// Rate reported alongside the per-iteration time.
+enum class Rate { None, Bytes, Items };
+
+struct Result {
+    std::string name;
+    size_t iterations;
+    double ns_per_iter;
+    double cpu_ns_per_iter;
+    Rate rate;
+    double per_second;  // bytes or items per second
+};
+
+std::vector<Result> g_results;
+
+// Human-readable table destination (stderr when JSON goes to stdout).
+FILE *g_table = stdout;
+
+// Whether --filter selects the case called name.
+bool selected(const Options &opt, const std::string &name) {
+    return opt.filter.empty() || name.find(opt.filter) != std::string::npos;
+}
+
+// Run body (which processes `units` bytes/items per call) until min_time
+// elapses, print the result and keep it for the JSON report.
+void run_case(const Options &opt, const std::string &name, Rate rate, double units,
+              const std::function<void()> &body) {
+    if (!selected(opt, name)) return;
+    using clock = std::chrono::steady_clock;
+    body();  // warm-up
+    size_t iters = 0;
+    const auto start = clock::now();
+    const std::clock_t cpu_start = std::clock();
+    double secs = 0;
+    do {
+        body();
+        ++iters;
+        secs = std::chrono::duration<double>(clock::now() - start).count();
+    } while (secs < opt.min_time);
+    const double cpu_secs = double(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+
+    Result r{name, iters, secs * 1e9 / iters, cpu_secs * 1e9 / iters, rate, units * iters / secs};
+    static const char *units_name[] = {"", "bytes/s", "items/s"};
+    if (rate == Rate::None) {
+        std::fprintf(g_table, "%-24s %14.1f ns/iter %10zu iters\n", name.c_str(), r.ns_per_iter, iters);
+    } else {
+        std::fprintf(g_table, "%-24s %14.1f ns/iter %10zu iters %16.0f %s\n", name.c_str(), r.ns_per_iter, iters,
+                    r.per_second, units_name[static_cast<int>(rate)]);
+    }
+    g_results.push_back(r);
+}
+
+// Keep the optimizer from discarding a computed value.
+template <class T> void keep(const T &v) {
+    volatile uint8_t sink = reinterpret_cast<const volatile uint8_t *>(&v)[0];
+    (void)sink;
+}
+
+std::string size_name(size_t n) {
+    if (n >= (1u << 30) && n % (1u << 30) == 0) return std::to_string(n >> 30) + "GiB";
+    if (n >= (1u << 20) && n % (1u << 20) == 0) return std::to_string(n >> 20) + "MiB";
+    if (n >= (1u << 10) && n % (1u << 10) == 0) return std::to_string(n >> 10) + "KiB";
+    return std::to_string(n) + "B";
+}
+
+// Fingerprint-shaped messages: "mid:<32 hex>|salt:prod-<n>".
+std::vector<std::string> fingerprint_messages(size_t n) {
+    std::vector<std::string> msgs;
+    msgs.reserve(n);
+    for (size_t i = 0; i < n; ++i) {
+        char mid[33];
+        std::snprintf(mid, sizeof mid, "%016llx%016llx",
+                      static_cast<unsigned long long>(i) * 0x9e3779b97f4a7c15ULL,
+                      static_cast<unsigned long long>(i));
+        msgs.push_back(std::string("mid:") + mid + "|salt:prod-" + std::to_string(i % 1000));
+    }
+    return msgs;
+}
+
+void bench_sha256(const Options &opt) {
+    const std::vector<uint8_t> buf(4096, 0x5a);
+    for (size_t n : {32, 64, 256, 1024, 4096}) {
+        const size_t reps = 1 + 65536 / n;  // amortize timer reads on small inputs
+        run_case(opt, "sha256/" + size_name(n), Rate::Bytes, double(n) * reps, [&] {
+            for (size_t r = 0; r < reps; ++r) {
+                oksi::SHA256 sha;
+                sha.update(buf.data(), n);
+                keep(sha.digest());
+            }
+        });
+    }
+}
+
+void bench_update(const Options &opt) {
+    const std::vector<uint8_t> buf(1 << 20, 0xa5);
+    struct Size { size_t chunk; size_t repeat; };
+    const Size sizes[] = {{1 << 10, 1}, {1 << 20, 1}, {1 << 20, 1024}};
+    for (const Size &sz : sizes) {
+        run_case(opt, "update/" + size_name(sz.chunk * sz.repeat), Rate::Bytes, double(sz.chunk) * sz.repeat, [&] {
+            oksi::SHA256 sha;
+            for (size_t r = 0; r < sz.repeat; ++r) sha.update(buf.data(), sz.chunk);
+            keep(sha.digest());
+        });
+    }
+}
+
+void bench_many(const Options &opt) {
+    using namespace oksi::sha256_detail;
+    const std::vector<std::string> msgs = fingerprint_messages(1 << 16);
+    std::vector<std::array<uint8_t,32>> digests(msgs.size());
+
+    std::vector<LaneEngine> engines{LaneEngine{"single", 1, nullptr}};
+    const LaneEngine &best = lane_engine();
+    if (best.lanes > 1) {
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+        if (best.lanes == 16) engines.push_back(LaneEngine{"avx2", 8, compress_x8_avx2});
+#endif
+        engines.push_back(best);
+    }
+    for (const LaneEngine &e : engines) {
+        run_case(opt, std::string("many/") + e.name, Rate::Items, double(msgs.size()), [&] {
+            sha256_many_with(e, msgs.data(), msgs.size(), digests.data());
+        });
+    }
+}
+
+void bench_base64(const Options &opt) {
+    const std::vector<uint8_t> buf(4096, 0x3c);
+    for (size_t n : {32, 4096}) {
+        const size_t reps = 1 + 65536 / n;
+        run_case(opt, "base64/" + size_name(n), Rate::Bytes, double(n) * reps, [&] {
+            for (size_t r = 0; r < reps; ++r) keep(oksi::base64_urlsafe_nopad(buf.data(), n).size());
+        });
+    }
+}
+
+void bench_read_file(const Options &opt) {
+    if (!selected(opt, "read_file")) return;
+    std::error_code ec;
+    const std::filesystem::path dir = std::filesystem::temp_directory_path(ec);
+    if (ec) {
+        std::fprintf(stderr, "read_file: skipped, no temp directory: %s\n", ec.message().c_str());
+        return;
+    }
+    const std::string path =
+        (dir / ("oksi_fingerprint_bench_mid_" + std::to_string(std::random_device{}()) + ".txt")).string();
+    {
+        std::ofstream f(path);
+        f << "0123456789abcdef0123456789abcdef\n";
+    }
+    run_case(opt, "read_file", Rate::None, 1, [&] { keep(oksi::read_file(path).size()); });
+    std::remove(path.c_str());
+}
+
+void bench_fingerprint(const Options &opt) {
+    const std::string mid = "0123456789abcdef0123456789abcdef";
+    run_case(opt, "fingerprint", Rate::Items, 1000, [&] {
+        for (int i = 0; i < 1000; ++i) keep(oksi::compute_fingerprint(mid, "prod-42").size());
+    });
+    const oksi::FingerprintPrefix prefix(mid);
+    run_case(opt, "fingerprint/prefix", Rate::Items, 1000, [&] {
+        for (int i = 0; i < 1000; ++i) keep(prefix.derive("prod-42").size());
+    });
+}
+
+void bench_cold_start(const Options &opt) {
+#if !defined(_WIN32)
+    if (opt.exe.empty()) return;
+    if (access(opt.exe.c_str(), X_OK) != 0) {
+        std::fprintf(stderr, "cold_start: skipped, %s is not executable\n", opt.exe.c_str());
+        return;
+    }
+    posix_spawn_file_actions_t actions;
+    posix_spawn_file_actions_init(&actions);
+    posix_spawn_file_actions_addopen(&actions, STDOUT_FILENO, "/dev/null", O_WRONLY, 0);
+    std::string exe = opt.exe, salt_flag = "--salt", salt = "prod-42";
+    char *args[] = {&exe[0], &salt_flag[0], &salt[0], nullptr};
+    run_case(opt, "cold_start", Rate::None, 1, [&] {
+        pid_t pid = 0;
+        int status = 0;
+        if (posix_spawn(&pid, exe.c_str(), &actions, nullptr, args, environ) == 0) waitpid(pid, &status, 0);
+    });
+    posix_spawn_file_actions_destroy(&actions);
+#else
+    (void)opt;
+#endif
+}
+
+void bench_serve(const Options &opt) {
+#if defined(__linux__)
+    if (opt.exe.empty() || access(opt.exe.c_str(), X_OK) != 0) return;
+    if (!selected(opt, "serve_roundtrip")) return;
+    const std::string sock = "/tmp/oksi_fp_bench_" + std::to_string(getpid()) + ".sock";
+    std::string exe = opt.exe, flag = "--serve", path = sock;
+    char *args[] = {&exe[0], &flag[0], &path[0], nullptr};
+    pid_t pid = 0;
+    if (posix_spawn(&pid, exe.c_str(), nullptr, nullptr, args, environ) != 0) return;
+
+    sockaddr_un addr{};
+    addr.sun_family = AF_UNIX;
+    std::snprintf(addr.sun_path, sizeof addr.sun_path, "%s", sock.c_str());
+    int fd = -1;
+    for (int i = 0; i < 200 && fd < 0; ++i) {
+        fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (connect(fd, reinterpret_cast<sockaddr*>(&addr), sizeof addr) != 0) {
+            close(fd);
+            fd = -1;
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+    if (fd >= 0) {
+        const char req[] = "GET prod-42\n";
+        char buf[64];
+        run_case(opt, "serve_roundtrip", Rate::None, 1, [&] {
+            if (write(fd, req, sizeof req - 1) != ssize_t(sizeof req - 1)) return;
+            ssize_t got = 0;
+            while (got == 0 || buf[got - 1] != '\n') {
+                ssize_t n = read(fd, buf + got, sizeof buf - got);
+                if (n <= 0) return;
+                got += n;
+            }
+        });
+        close(fd);
+    }
+    kill(pid, SIGTERM);
+    waitpid(pid, nullptr, 0);
+#else
+    (void)opt;
+#endif
+}
+
+std::string json_escape(const std::string &s) {
+    std::string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out.push_back('\\');
+        out.push_back(c);
+    }
+    return out;
+}
+
+bool write_json(const std::string &path) {
+    char date[32] = "";
+    const std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof date, "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    std::string out = "{\n  \"context\": {\n";
+    out += "    \"date\": \"" + std::string(date) + "\",\n";
+    out += "    \"library_build_type\": \"" OKSI_BENCH_BUILD_TYPE "\",\n";
+    out += "    \"sha256_backend\": \"" + std::string(oksi::sha256_detail::compress_name()) + "\",\n";
+    out += "    \"sha256_many_engine\": \"" + std::string(oksi::sha256_many_name()) + "\",\n";
+    out += "    \"sha256_many_lanes\": " + std::to_string(oksi::sha256_many_lanes()) + "\n";
+    out += "  },\n  \"benchmarks\": [";
+    for (size_t i = 0; i < g_results.size(); ++i) {
+        const Result &r = g_results[i];
+        char num[64];
+        out += i ? ",\n" : "\n";
+        out += "    {\n";
+        out += "      \"name\": \"" + json_escape(r.name) + "\",\n";
+        out += "      \"run_type\": \"iteration\",\n";
+        out += "      \"iterations\": " + std::to_string(r.iterations) + ",\n";
+        std::snprintf(num, sizeof num, "%.3f", r.ns_per_iter);
+        out += "      \"real_time\": " + std::string(num) + ",\n";
+        std::snprintf(num, sizeof num, "%.3f", r.cpu_ns_per_iter);
+        out += "      \"cpu_time\": " + std::string(num) + ",\n";
+        out += "      \"time_unit\": \"ns\"";
+        if (r.rate != Rate::None) {
+            std::snprintf(num, sizeof num, "%.3f", r.per_second);
+            out += std::string(",\n      \"") + (r.rate == Rate::Bytes ? "bytes_per_second" : "items_per_second") + "\": " + num;
+        }
+        out += "\n    }";
+    }
+    out += "\n  ]\n}\n";
+
+    if (path == "-") return std::fwrite(out.data(), 1, out.size(), stdout) == out.size();
+    std::ofstream f(path);
+    f << out;
+    return f.good();
+}
+
+// Default cold-start target: oksi_fingerprint next to this executable.
+std::string sibling_exe(const char *argv0) {
+    std::string self = argv0 ? argv0 : "";
+    size_t slash = self.find_last_of('/');
+    return (slash == std::string::npos ? std::string("./") : self.substr(0, slash + 1)) + "oksi_fingerprint";
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+    Options opt;
+    opt.exe = sibling_exe(argv[0]);
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "--filter" && i + 1 < argc) {
+            opt.filter = argv[++i];
+        } else if (a == "--min-time" && i + 1 < argc) {
+            opt.min_time = std::atof(argv[++i]);
+        } else if (a == "--json" && i + 1 < argc) {
+            opt.json = argv[++i];
+        } else if (a == "--exe" && i + 1 < argc) {
+            opt.exe = argv[++i];
+        }
+    }
+
+    // Keep stdout pure JSON when it is the report destination
+    if (opt.json == "-") g_table = stderr;
+    std::fprintf(g_table, "sha256 backend: %s, multi-lane engine: %s (%zu lanes)\n",
+                oksi::sha256_detail::compress_name(), oksi::sha256_many_name(), oksi::sha256_many_lanes());
+    bench_sha256(opt);
+    bench_update(opt);
+    bench_many(opt);
+    bench_base64(opt);
+    bench_read_file(opt);
+    bench_fingerprint(opt);
+    bench_cold_start(opt);
+    bench_serve(opt);
+
+    if (!opt.json.empty() && !write_json(opt.json)) {
+        std::fprintf(stderr, "failed to write %s\n", opt.json.c_str());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,35 @@
+// Crypto Primitives for Machine-File Verification (C++)
+// ---------------------------------
+// Purpose:
+//   Minimal, dependency-free primitives needed by oksi_verify to check Keygen
+//   machine files natively: SHA-512 (for Ed25519), Ed25519 signature
+//   verification and AES-256-GCM decryption. SHA-256 comes from sha256.hpp.
+//
+// Scope:
+//   Verification/decryption only; no signing or encryption APIs. Inputs are
+//   public (signatures) or already known to the caller (license key), so the
+//   table-based AES here is not hardened against cache-timing observers.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace oksi {
+
+// SHA-512 digest of data[0..len).
+std::array<uint8_t,64> sha512(const uint8_t *data, size_t len);
+
+// RFC 8032 Ed25519 verification of sig over msg with public key pk.
+// Rejects non-canonical S (S >= L) and public keys that do not decode.
+bool ed25519_verify(const uint8_t sig[64], const uint8_t *msg, size_t len, const uint8_t pk[32]);
+
+// AES-256-GCM decryption with a 96-bit IV, a 128-bit tag and no AAD.
+// On success writes the plaintext to out and returns true; returns false
+// (leaving out empty) if the tag does not authenticate.
+bool aes256_gcm_decrypt(const uint8_t key[32], const uint8_t iv[12], const uint8_t *ct, size_t len,
+                        const uint8_t tag[16], std::vector<uint8_t> &out);
+
+} // namespace oksi
@@ -0,0 +1,78 @@
+// Compile-Time Fingerprints (C++)
+// ---------------------------------
+// Purpose:
+//   Derive fingerprints in constant expressions, for binaries that embed a
+//   fixed product salt (and, on golden appliance images, a fixed machine id):
+//   the expected value becomes a constant and the runtime only compares.
+//
+// Usage:
+//   constexpr auto kGolden = oksi::fingerprint_of("<machine-id>", "<salt>");  // C++17
+//   constexpr auto kGolden = oksi::fingerprint_v<"<machine-id>", "<salt>">;   // C++20
+//   if (runtime_fp == kGolden.view()) ...
+//
+// The derivation is the one in fingerprint_core.hpp (empty values omitted);
+// pass the machine id as read_file() returns it, i.e. already trimmed.
+
+#pragma once
+
+#include "sha256.hpp"
+
+#include <cstddef>
+#include <string_view>
+
+#if !OKSI_HAVE_CONSTEXPR_SHA256
+#  error "fingerprint_constexpr.hpp requires std::is_constant_evaluated or __builtin_is_constant_evaluated"
+#endif
+
+namespace oksi {
+
+// Length of an encoded fingerprint (43, matching OKSI_FINGERPRINT_LEN).
+inline constexpr size_t kFingerprintLen = base64_urlsafe_nopad_len(32);
+
+// Fixed-size, NUL-terminated fingerprint usable as a constant.
+struct StaticFingerprint {
+    char chars[kFingerprintLen + 1] = {};
+
+    constexpr std::string_view view() const { return std::string_view(chars, kFingerprintLen); }
+    constexpr const char *c_str() const { return chars; }
+};
+
+constexpr bool operator==(const StaticFingerprint &a, const StaticFingerprint &b) { return a.view() == b.view(); }
+constexpr bool operator!=(const StaticFingerprint &a, const StaticFingerprint &b) { return !(a == b); }
+
+// Constexpr counterpart of compute_fingerprint(machine_id, salt).
+constexpr StaticFingerprint fingerprint_of(std::string_view machine_id, std::string_view salt) {
+    SHA256 sha;
+    if (!machine_id.empty()) {
+        sha.update("mid:");
+        sha.update(machine_id);
+    }
+    if (!machine_id.empty() && !salt.empty()) sha.update("|");
+    if (!salt.empty()) {
+        sha.update("salt:");
+        sha.update(salt);
+    }
+    const std::array<uint8_t,32> dig = sha.digest();
+    StaticFingerprint fp;
+    base64_urlsafe_nopad(dig.data(), dig.size(), fp.chars);
+    return fp;
+}
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+// String literal wrapper usable as a template argument (C++20).
+template <size_t N>
+struct FixedString {
+    char value[N] = {};
+
+    constexpr FixedString(const char (&s)[N]) {
+        for (size_t i = 0; i < N; ++i) value[i] = s[i];
+    }
+    constexpr std::string_view view() const { return std::string_view(value, N - 1); }
+};
+
+// fingerprint_v<"mid", "salt">: the fingerprint as a compile-time constant.
+template <FixedString MachineId, FixedString Salt = "">
+inline constexpr StaticFingerprint fingerprint_v = fingerprint_of(MachineId.view(), Salt.view());
+#endif
+
+} // namespace oksi
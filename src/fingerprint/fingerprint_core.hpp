@@ -0,0 +1,46 @@
+// Fingerprint Core (C++)
+// ---------------------------------
+// Purpose:
+//   Internal C++ API behind liboksi_fingerprint. The CLI links it statically;
+//   external consumers should use the C ABI in oksi_fingerprint.h instead.
+
+#pragma once
+
+#include "sha256.hpp"
+
+#include <string>
+
+namespace oksi {
+
+// Default machine-id source on Linux hosts.
+constexpr const char *kDefaultMachineIdPath = "/etc/machine-id";
+
+// Trim helper: removes whitespace from both ends of a string.
+std::string trim(const std::string &s);
+
+// Read entire file into a string (best-effort, trimmed). Returns empty on failure.
+std::string read_file(const std::string &path);
+
+// Hashed input for a machine id and optional salt: "mid:<id>|salt:<salt>",
+// with empty values omitted.
+std::string fingerprint_input(const std::string &machine_id, const std::string &salt);
+
+// Compute the fingerprint for an already-read machine id and optional salt.
+// Empty values are omitted from the hashed input.
+std::string compute_fingerprint(const std::string &machine_id, const std::string &salt);
+
+// Fingerprints of one machine id under many salts. The shared "mid:<id>|salt:"
+// prefix is hashed once at construction; derive() forks that state and hashes
+// only the salt. Output is identical to compute_fingerprint(machine_id, salt).
+class FingerprintPrefix {
+public:
+    explicit FingerprintPrefix(const std::string &machine_id);
+
+    std::string derive(const std::string &salt) const;
+
+private:
+    std::string m_unsalted;  // fingerprint for an empty salt (no "|salt:" part)
+    SHA256 m_salted;         // state after "mid:<id>|salt:" (or "salt:")
+};
+
+} // namespace oksi
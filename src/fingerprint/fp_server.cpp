@@ -0,0 +1,340 @@
+// Fingerprint Daemon (C++)
+// ---------------------------------
+// Event loop:
+//   One thread, level-triggered epoll over the listening socket and all
+//   clients; sockets are non-blocking. Each connection keeps an input buffer
+//   (partial request lines) and an output buffer (responses not yet written);
+//   EPOLLOUT is only armed while output is pending.
+//
+// Limits:
+//   Request lines longer than kMaxLine close the connection. The salt cache
+//   is dropped once it holds kMaxCache entries so arbitrary salts cannot grow
+//   the daemon without bound.
+//
+// Backpressure:
+//   Once a connection has kMaxPending bytes of unsent replies, the daemon
+//   stops reading from it (EPOLLOUT only) and resumes when the peer drains
+//   them, so a client that pipelines without reading cannot grow the daemon.
+//   A half-closed peer is likewise only watched for EPOLLOUT. If accept()
+//   runs out of descriptors the listening socket is dropped from epoll and
+//   retried on the next wakeup (at most kAcceptRetryMs later).
+//
+// Socket path:
+//   An existing path is only replaced if it is a socket nobody is listening
+//   on (a stale socket from a previous run); anything else is an error.
+//
+// Socket permissions:
+//   The socket is created mode 0666: the fingerprint is derived from
+//   /etc/machine-id, which is world-readable anyway.
+
+#include "fp_server.hpp"
+
+#include "fingerprint_core.hpp"
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <unordered_map>
+
+#if defined(__linux__)
+
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+namespace oksi {
+
+namespace {
+
+constexpr size_t kMaxLine = 4096;
+constexpr size_t kMaxCache = 4096;
+constexpr size_t kMaxPending = 64 * 1024;
+constexpr int kMaxEvents = 64;
+constexpr int kAcceptRetryMs = 100;
+
+volatile std::sig_atomic_t g_stop = 0;
+
+void on_signal(int) { g_stop = 1; }
+
+struct Conn {
+    std::string in;
+    std::string out;
+    bool closing = false;  // peer finished sending; close once out drains
+    uint32_t events = EPOLLIN | EPOLLRDHUP;  // current epoll registration
+};
+
+class Server {
+public:
+    explicit Server(const std::string &machine_id)
+        : m_prefix(machine_id), m_no_salt(m_prefix.derive("")) {}
+
+    int run(const std::string &socket_path);
+
+private:
+    FingerprintPrefix m_prefix;  // "mid:<id>|salt:" hashed once; misses only hash the salt
+    std::string m_no_salt;  // salt-less fingerprint, computed once
+    std::unordered_map<std::string, std::string> m_cache;
+    std::unordered_map<int, Conn> m_conns;
+    int m_ep = -1;
+    int m_lfd = -1;
+    bool m_accept_paused = false;  // listening fd removed from epoll (EMFILE)
+
+    const std::string &lookup(const std::string &salt) {
+        if (salt.empty()) return m_no_salt;
+        auto it = m_cache.find(salt);
+        if (it != m_cache.end()) return it->second;
+        if (m_cache.size() >= kMaxCache) m_cache.clear();
+        return m_cache.emplace(salt, m_prefix.derive(salt)).first->second;
+    }
+
+    void respond(const std::string &line, std::string &out) {
+        if (line == "GET") {
+            out += m_no_salt;
+        } else if (line.compare(0, 4, "GET ") == 0) {
+            out += lookup(line.substr(4));
+        } else {
+            out += "ERR bad request";
+        }
+        out.push_back('\n');
+    }
+
+    void close_conn(int fd) {
+        epoll_ctl(m_ep, EPOLL_CTL_DEL, fd, nullptr);
+        close(fd);
+        m_conns.erase(fd);
+    }
+
+    // Register interest matching the connection state: input only while the
+    // peer may still send and pending output is under kMaxPending, output
+    // only while replies are pending.
+    void watch(int fd, Conn &c) {
+        const bool want_in = !c.closing && c.out.size() < kMaxPending;
+        const uint32_t events = (want_in ? uint32_t(EPOLLIN | EPOLLRDHUP) : 0u) |
+                                (!c.out.empty() ? uint32_t(EPOLLOUT) : 0u);
+        if (events == c.events) return;
+        epoll_event ev{};
+        ev.events = events;
+        ev.data.fd = fd;
+        epoll_ctl(m_ep, EPOLL_CTL_MOD, fd, &ev);
+        c.events = events;
+    }
+
+    void set_accepting(bool on) {
+        if (on == !m_accept_paused) return;
+        epoll_event ev{};
+        ev.events = EPOLLIN;
+        ev.data.fd = m_lfd;
+        epoll_ctl(m_ep, on ? EPOLL_CTL_ADD : EPOLL_CTL_DEL, m_lfd, &ev);
+        m_accept_paused = !on;
+    }
+
+    void accept_all() {
+        for (;;) {
+            int fd = accept4(m_lfd, nullptr, nullptr, SOCK_NONBLOCK | SOCK_CLOEXEC);
+            if (fd < 0) {
+                // Out of descriptors/memory: the listening fd stays readable,
+                // so stop watching it instead of spinning
+                if (errno == EMFILE || errno == ENFILE || errno == ENOBUFS || errno == ENOMEM)
+                    set_accepting(false);
+                return;  // EAGAIN or transient error
+            }
+            epoll_event ev{};
+            ev.events = EPOLLIN | EPOLLRDHUP;
+            ev.data.fd = fd;
+            if (epoll_ctl(m_ep, EPOLL_CTL_ADD, fd, &ev) != 0) {
+                close(fd);
+                continue;
+            }
+            m_conns[fd];
+        }
+    }
+
+    // Answer buffered complete lines until kMaxPending bytes of output are
+    // queued; the rest wait in c.in until the peer drains its replies.
+    void process(Conn &c) {
+        size_t start = 0, nl;
+        while (c.out.size() < kMaxPending && (nl = c.in.find('\n', start)) != std::string::npos) {
+            size_t end = nl;
+            if (end > start && c.in[end - 1] == '\r') end--;
+            respond(c.in.substr(start, end - start), c.out);
+            start = nl + 1;
+        }
+        c.in.erase(0, start);
+    }
+
+    // Write as much pending output as the socket takes, then answer any
+    // requests held back by the output cap. Returns false if the connection
+    // should be closed.
+    bool flush(int fd, Conn &c) {
+        size_t off = 0;
+        while (off < c.out.size()) {
+            ssize_t n = send(fd, c.out.data() + off, c.out.size() - off, MSG_NOSIGNAL);
+            if (n > 0) { off += static_cast<size_t>(n); continue; }
+            if (n < 0 && errno == EINTR) continue;
+            if (n < 0 && (errno == EAGAIN || errno == EWOULDBLOCK)) break;
+            return false;
+        }
+        c.out.erase(0, off);
+        process(c);
+        if (c.out.empty() && c.closing) return false;
+        watch(fd, c);
+        return true;
+    }
+
+    // Read available input and queue responses for every complete line,
+    // stopping once the output cap is reached.
+    bool on_readable(int fd, Conn &c) {
+        char buf[4096];
+        while (!c.closing && c.out.size() < kMaxPending) {
+            ssize_t n = recv(fd, buf, sizeof buf, 0);
+            if (n > 0) {
+                c.in.append(buf, static_cast<size_t>(n));
+                process(c);
+                if (c.in.size() > kMaxLine && c.in.find('\n') == std::string::npos) return false;
+                continue;
+            }
+            if (n == 0) { c.closing = true; break; }
+            if (errno == EINTR) continue;
+            if (errno == EAGAIN || errno == EWOULDBLOCK) break;
+            return false;
+        }
+        return flush(fd, c);
+    }
+
+    int bind_socket(const std::string &socket_path, const sockaddr_un &addr);
+};
+
+// Create and bind the listening socket. An existing path is replaced only if
+// it is a stale socket (connect() is refused); a live daemon's socket or any
+// other file is left alone. Returns the fd, or -1 after printing the error.
+int Server::bind_socket(const std::string &socket_path, const sockaddr_un &addr) {
+    struct stat st{};
+    if (lstat(socket_path.c_str(), &st) == 0) {
+        if (!S_ISSOCK(st.st_mode)) {
+            std::fprintf(stderr, "%s: exists and is not a socket\n", socket_path.c_str());
+            return -1;
+        }
+        int probe = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+        if (probe < 0) { std::perror("socket"); return -1; }
+        const int rc = connect(probe, reinterpret_cast<const sockaddr*>(&addr), sizeof addr);
+        const int err = errno;
+        close(probe);
+        if (rc == 0 || err != ECONNREFUSED) {
+            std::fprintf(stderr, "%s: %s\n", socket_path.c_str(),
+                         rc == 0 || err == EAGAIN ? "already in use by a running server" : std::strerror(err));
+            return -1;
+        }
+        unlink(socket_path.c_str());  // stale socket from a previous run
+    }
+
+    int lfd = socket(AF_UNIX, SOCK_STREAM | SOCK_NONBLOCK | SOCK_CLOEXEC, 0);
+    if (lfd < 0) { std::perror("socket"); return -1; }
+    if (bind(lfd, reinterpret_cast<const sockaddr*>(&addr), sizeof addr) != 0) {
+        std::perror(socket_path.c_str());
+        close(lfd);
+        return -1;
+    }
+    if (listen(lfd, SOMAXCONN) != 0) {
+        std::perror(socket_path.c_str());
+        close(lfd);
+        unlink(socket_path.c_str());
+        return -1;
+    }
+    return lfd;
+}
+
+int Server::run(const std::string &socket_path) {
+    sockaddr_un addr{};
+    if (socket_path.size() >= sizeof addr.sun_path) {
+        std::fprintf(stderr, "socket path too long: %s\n", socket_path.c_str());
+        return 1;
+    }
+    addr.sun_family = AF_UNIX;
+    std::memcpy(addr.sun_path, socket_path.c_str(), socket_path.size() + 1);
+
+    // Best-effort: create the parent directory (e.g. /run/oksi)
+    size_t slash = socket_path.find_last_of('/');
+    if (slash != std::string::npos && slash > 0) mkdir(socket_path.substr(0, slash).c_str(), 0755);
+
+    const int lfd = bind_socket(socket_path, addr);
+    if (lfd < 0) return 1;
+    m_lfd = lfd;
+    chmod(socket_path.c_str(), 0666);
+
+    m_ep = epoll_create1(EPOLL_CLOEXEC);
+    epoll_event lev{};
+    lev.events = EPOLLIN;
+    lev.data.fd = lfd;
+    if (m_ep < 0 || epoll_ctl(m_ep, EPOLL_CTL_ADD, lfd, &lev) != 0) {
+        std::perror("epoll");
+        close(lfd);
+        unlink(socket_path.c_str());
+        return 1;
+    }
+
+    struct sigaction sa{};
+    sa.sa_handler = on_signal;  // no SA_RESTART: epoll_wait returns EINTR
+    sigemptyset(&sa.sa_mask);
+    sigaction(SIGINT, &sa, nullptr);
+    sigaction(SIGTERM, &sa, nullptr);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    epoll_event events[kMaxEvents];
+    int rc = 0;
+    while (!g_stop) {
+        int n = epoll_wait(m_ep, events, kMaxEvents, m_accept_paused ? kAcceptRetryMs : -1);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            std::perror("epoll_wait");
+            rc = 1;
+            break;
+        }
+        if (m_accept_paused) set_accepting(true);
+        for (int i = 0; i < n; ++i) {
+            const int fd = events[i].data.fd;
+            if (fd == lfd) { accept_all(); continue; }
+            auto it = m_conns.find(fd);
+            if (it == m_conns.end()) continue;
+            Conn &c = it->second;
+            bool keep = true;
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP)) keep = on_readable(fd, c);
+            else if (events[i].events & EPOLLOUT) keep = flush(fd, c);
+            if (keep && (events[i].events & EPOLLERR)) keep = false;
+            if (!keep) close_conn(fd);
+        }
+    }
+
+    for (auto &kv : m_conns) close(kv.first);
+    m_conns.clear();
+    close(m_ep);
+    close(lfd);
+    unlink(socket_path.c_str());
+    return rc;
+}
+
+} // namespace
+
+int serve(const std::string &socket_path, const std::string &machine_id) {
+    Server server(machine_id);
+    return server.run(socket_path);
+}
+
+} // namespace oksi
+
+#else
+
+namespace oksi {
+
+int serve(const std::string &socket_path, const std::string &) {
+    std::fprintf(stderr, "--serve %s: not supported on this platform\n", socket_path.c_str());
+    return 1;
+}
+
+} // namespace oksi
+
+#endif
@@ -0,0 +1,24 @@
+// Fingerprint Daemon (C++)
+// ---------------------------------
+// Purpose:
+//   Long-lived server behind `oksi_fingerprint --serve <socket>`. Answers
+//   fingerprint requests over a Unix domain socket so local callers (CLI,
+//   heartbeat and verify scripts) avoid a fork+exec per lookup.
+//
+// Protocol (line based, requests may be pipelined on one connection):
+//   request:  "GET\n" (no salt) or "GET <salt>\n"
+//   response: "<fingerprint>\n" or "ERR <reason>\n"
+//
+// The machine id is read once at startup; per-salt fingerprints are cached
+// in memory. Linux only (epoll); elsewhere serve() reports an error.
+
+#pragma once
+
+#include <string>
+
+namespace oksi {
+
+// Serve until SIGINT/SIGTERM. Returns the process exit code.
+int serve(const std::string &socket_path, const std::string &machine_id);
+
+} // namespace oksi
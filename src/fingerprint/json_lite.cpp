@@ -0,0 +1,386 @@
+// Minimal JSON (C++)
+// ---------------------------------
+// Recursive-descent parser and Python-compatible pretty printer; see
+// json_lite.hpp for the compatibility rules.
+
+#include "json_lite.hpp"
+
+#include <charconv>
+#include <cmath>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+
+namespace oksi {
+
+namespace {
+
+class Parser {
+public:
+    explicit Parser(const std::string &s) : m_s(s) {}
+
+    JsonValue document() {
+        JsonValue v = value(0);
+        skip_ws();
+        if (m_pos != m_s.size()) fail("extra data");
+        return v;
+    }
+
+private:
+    static constexpr int kMaxDepth = 512;
+
+    const std::string &m_s;
+    size_t m_pos = 0;
+
+    [[noreturn]] void fail(const char *what) const {
+        throw std::runtime_error(std::string(what) + " at offset " + std::to_string(m_pos));
+    }
+
+    void skip_ws() {
+        while (m_pos < m_s.size() &&
+               (m_s[m_pos] == ' ' || m_s[m_pos] == '\t' || m_s[m_pos] == '\n' || m_s[m_pos] == '\r'))
+            ++m_pos;
+    }
+
+    bool consume(const char *lit) {
+        const size_t n = std::strlen(lit);
+        if (m_s.compare(m_pos, n, lit) != 0) return false;
+        m_pos += n;
+        return true;
+    }
+
+    JsonValue value(int depth) {
+        if (depth > kMaxDepth) fail("nesting too deep");
+        skip_ws();
+        if (m_pos >= m_s.size()) fail("expecting value");
+        JsonValue v;
+        const char c = m_s[m_pos];
+        if (c == '{') {
+            object(v, depth);
+        } else if (c == '[') {
+            array(v, depth);
+        } else if (c == '"') {
+            v.type = JsonValue::Type::String;
+            v.str = string();
+        } else if (consume("true")) {
+            v.type = JsonValue::Type::Bool;
+            v.boolean = true;
+        } else if (consume("false")) {
+            v.type = JsonValue::Type::Bool;
+        } else if (consume("null")) {
+            // Null is the default
+        } else if (consume("NaN")) {
+            v.type = JsonValue::Type::Number;
+            v.str = "NaN";
+        } else if (consume("Infinity")) {
+            v.type = JsonValue::Type::Number;
+            v.str = "Infinity";
+        } else if (consume("-Infinity")) {
+            v.type = JsonValue::Type::Number;
+            v.str = "-Infinity";
+        } else {
+            v.type = JsonValue::Type::Number;
+            v.str = number();
+        }
+        return v;
+    }
+
+    void object(JsonValue &v, int depth) {
+        v.type = JsonValue::Type::Object;
+        ++m_pos;
+        skip_ws();
+        if (m_pos < m_s.size() && m_s[m_pos] == '}') { ++m_pos; return; }
+        for (;;) {
+            skip_ws();
+            if (m_pos >= m_s.size() || m_s[m_pos] != '"') fail("expecting property name");
+            std::string key = string();
+            skip_ws();
+            if (m_pos >= m_s.size() || m_s[m_pos] != ':') fail("expecting ':' delimiter");
+            ++m_pos;
+            JsonValue item = value(depth + 1);
+            bool replaced = false;
+            for (auto &m : v.members) {
+                if (m.first == key) { m.second = std::move(item); replaced = true; break; }
+            }
+            if (!replaced) v.members.emplace_back(std::move(key), std::move(item));
+            skip_ws();
+            if (m_pos < m_s.size() && m_s[m_pos] == ',') { ++m_pos; continue; }
+            if (m_pos < m_s.size() && m_s[m_pos] == '}') { ++m_pos; return; }
+            fail("expecting ',' delimiter");
+        }
+    }
+
+    void array(JsonValue &v, int depth) {
+        v.type = JsonValue::Type::Array;
+        ++m_pos;
+        skip_ws();
+        if (m_pos < m_s.size() && m_s[m_pos] == ']') { ++m_pos; return; }
+        for (;;) {
+            v.items.push_back(value(depth + 1));
+            skip_ws();
+            if (m_pos < m_s.size() && m_s[m_pos] == ',') { ++m_pos; continue; }
+            if (m_pos < m_s.size() && m_s[m_pos] == ']') { ++m_pos; return; }
+            fail("expecting ',' delimiter");
+        }
+    }
+
+    std::string number() {
+        const size_t start = m_pos;
+        auto digits = [&] {
+            const size_t d = m_pos;
+            while (m_pos < m_s.size() && m_s[m_pos] >= '0' && m_s[m_pos] <= '9') ++m_pos;
+            return m_pos - d;
+        };
+        if (m_pos < m_s.size() && m_s[m_pos] == '-') ++m_pos;
+        if (m_pos < m_s.size() && m_s[m_pos] == '0') {
+            ++m_pos;
+        } else if (digits() == 0) {
+            m_pos = start;
+            fail("expecting value");
+        }
+        if (m_pos < m_s.size() && m_s[m_pos] == '.') {
+            ++m_pos;
+            if (digits() == 0) fail("invalid number");
+        }
+        if (m_pos < m_s.size() && (m_s[m_pos] == 'e' || m_s[m_pos] == 'E')) {
+            ++m_pos;
+            if (m_pos < m_s.size() && (m_s[m_pos] == '+' || m_s[m_pos] == '-')) ++m_pos;
+            if (digits() == 0) fail("invalid number");
+        }
+        return m_s.substr(start, m_pos - start);
+    }
+
+    unsigned hex4() {
+        if (m_pos + 4 > m_s.size()) fail("invalid \\uXXXX escape");
+        unsigned v = 0;
+        for (int i = 0; i < 4; ++i) {
+            const char c = m_s[m_pos++];
+            v <<= 4;
+            if (c >= '0' && c <= '9') v |= unsigned(c - '0');
+            else if (c >= 'a' && c <= 'f') v |= unsigned(c - 'a' + 10);
+            else if (c >= 'A' && c <= 'F') v |= unsigned(c - 'A' + 10);
+            else fail("invalid \\uXXXX escape");
+        }
+        return v;
+    }
+
+    static void put_utf8(std::string &out, unsigned cp) {
+        if (cp < 0x80) {
+            out += char(cp);
+        } else if (cp < 0x800) {
+            out += char(0xc0 | (cp >> 6));
+            out += char(0x80 | (cp & 0x3f));
+        } else if (cp < 0x10000) {
+            out += char(0xe0 | (cp >> 12));
+            out += char(0x80 | ((cp >> 6) & 0x3f));
+            out += char(0x80 | (cp & 0x3f));
+        } else {
+            out += char(0xf0 | (cp >> 18));
+            out += char(0x80 | ((cp >> 12) & 0x3f));
+            out += char(0x80 | ((cp >> 6) & 0x3f));
+            out += char(0x80 | (cp & 0x3f));
+        }
+    }
+
+    std::string string() {
+        ++m_pos;  // opening quote
+        std::string out;
+        for (;;) {
+            if (m_pos >= m_s.size()) fail("unterminated string");
+            const unsigned char c = static_cast<unsigned char>(m_s[m_pos++]);
+            if (c == '"') return out;
+            if (c < 0x20) fail("invalid control character");
+            if (c != '\\') { out += char(c); continue; }
+            if (m_pos >= m_s.size()) fail("unterminated string");
+            switch (m_s[m_pos++]) {
+            case '"': out += '"'; break;
+            case '\\': out += '\\'; break;
+            case '/': out += '/'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'n': out += '\n'; break;
+            case 'r': out += '\r'; break;
+            case 't': out += '\t'; break;
+            case 'u': {
+                unsigned cp = hex4();
+                // Combine a surrogate pair; lone surrogates pass through like Python
+                if (cp >= 0xd800 && cp < 0xdc00 && m_s.compare(m_pos, 2, "\\u") == 0) {
+                    const size_t save = m_pos;
+                    m_pos += 2;
+                    const unsigned lo = hex4();
+                    if (lo >= 0xdc00 && lo < 0xe000) cp = 0x10000 + ((cp - 0xd800) << 10) + (lo - 0xdc00);
+                    else m_pos = save;
+                }
+                put_utf8(out, cp);
+                break;
+            }
+            default: fail("invalid escape");
+            }
+        }
+    }
+};
+
+// Strict UTF-8 check (no overlongs, surrogates or code points > U+10FFFF),
+// matching Python's bytes.decode("utf-8").
+bool valid_utf8(const std::string &s) {
+    for (size_t i = 0; i < s.size();) {
+        const unsigned char c = static_cast<unsigned char>(s[i]);
+        size_t n;
+        unsigned cp, min;
+        if (c < 0x80) { ++i; continue; }
+        if ((c & 0xe0) == 0xc0) { n = 1; cp = c & 0x1f; min = 0x80; }
+        else if ((c & 0xf0) == 0xe0) { n = 2; cp = c & 0x0f; min = 0x800; }
+        else if ((c & 0xf8) == 0xf0) { n = 3; cp = c & 0x07; min = 0x10000; }
+        else return false;
+        if (i + n >= s.size()) return false;
+        for (size_t k = 1; k <= n; ++k) {
+            const unsigned char cc = static_cast<unsigned char>(s[i + k]);
+            if ((cc & 0xc0) != 0x80) return false;
+            cp = (cp << 6) | (cc & 0x3f);
+        }
+        if (cp < min || cp > 0x10ffff || (cp >= 0xd800 && cp < 0xe000)) return false;
+        i += n + 1;
+    }
+    return true;
+}
+
+// Next code point from UTF-8; input was checked by valid_utf8() before
+// parsing, and the parser only appends well-formed sequences.
+unsigned next_cp(const std::string &s, size_t &i) {
+    const unsigned char c = static_cast<unsigned char>(s[i++]);
+    int extra = c >= 0xf0 ? 3 : c >= 0xe0 ? 2 : c >= 0xc0 ? 1 : 0;
+    unsigned cp = extra == 3 ? (c & 0x07) : extra == 2 ? (c & 0x0f) : extra == 1 ? (c & 0x1f) : c;
+    while (extra-- > 0 && i < s.size()) cp = (cp << 6) | (static_cast<unsigned char>(s[i++]) & 0x3f);
+    return cp;
+}
+
+void dump_string(std::string &out, const std::string &s) {
+    static const char hex[] = "0123456789abcdef";
+    auto u16 = [&](unsigned v) {
+        out += "\\u";
+        for (int sh = 12; sh >= 0; sh -= 4) out += hex[(v >> sh) & 0xf];
+    };
+    out += '"';
+    for (size_t i = 0; i < s.size();) {
+        const unsigned cp = next_cp(s, i);
+        switch (cp) {
+        case '"': out += "\\\""; break;
+        case '\\': out += "\\\\"; break;
+        case '\n': out += "\\n"; break;
+        case '\r': out += "\\r"; break;
+        case '\t': out += "\\t"; break;
+        case '\b': out += "\\b"; break;
+        case '\f': out += "\\f"; break;
+        default:
+            if (cp >= 0x20 && cp < 0x7f) {
+                out += char(cp);
+            } else if (cp >= 0x10000) {
+                u16(0xd800 + ((cp - 0x10000) >> 10));
+                u16(0xdc00 + ((cp - 0x10000) & 0x3ff));
+            } else {
+                u16(cp);
+            }
+        }
+    }
+    out += '"';
+}
+
+// Python float repr: shortest round-trip digits, scientific notation when the
+// exponent is < -4 or >= 16, and always a '.0' or exponent on integral values.
+std::string python_float(const std::string &token) {
+    if (token == "NaN" || token == "Infinity" || token == "-Infinity") return token;
+    const double d = std::strtod(token.c_str(), nullptr);
+    if (std::isinf(d)) return d < 0 ? "-Infinity" : "Infinity";
+
+    char buf[64];
+    const auto res = std::to_chars(buf, buf + sizeof buf, d, std::chars_format::scientific);
+    const std::string sci(buf, res.ptr);
+    // sci is "[-]D[.DDD]e[+-]XX"
+    const size_t epos = sci.find('e');
+    const bool neg = sci[0] == '-';
+    std::string digits;
+    for (size_t i = neg ? 1 : 0; i < epos; ++i)
+        if (sci[i] != '.') digits += sci[i];
+    const int exp = std::atoi(sci.c_str() + epos + 1);
+
+    std::string out = neg ? "-" : "";
+    if (exp < -4 || exp >= 16) {
+        out += digits[0];
+        if (digits.size() > 1) out += "." + digits.substr(1);
+        out += exp < 0 ? "e-" : "e+";
+        const int ax = exp < 0 ? -exp : exp;
+        if (ax < 10) out += '0';
+        out += std::to_string(ax);
+    } else if (exp < 0) {
+        out += "0." + std::string(size_t(-exp - 1), '0') + digits;
+    } else if (size_t(exp) + 1 >= digits.size()) {
+        out += digits + std::string(size_t(exp) + 1 - digits.size(), '0') + ".0";
+    } else {
+        out += digits.substr(0, size_t(exp) + 1) + "." + digits.substr(size_t(exp) + 1);
+    }
+    return out;
+}
+
+std::string dump_number(const std::string &token) {
+    if (token.find_first_of(".eEIN") != std::string::npos) return python_float(token);
+    return token == "-0" ? "0" : token;
+}
+
+void dump(std::string &out, const JsonValue &v, int indent, int level) {
+    auto newline = [&](int lvl) {
+        out += '\n';
+        out.append(size_t(indent) * size_t(lvl), ' ');
+    };
+    switch (v.type) {
+    case JsonValue::Type::Null: out += "null"; break;
+    case JsonValue::Type::Bool: out += v.boolean ? "true" : "false"; break;
+    case JsonValue::Type::Number: out += dump_number(v.str); break;
+    case JsonValue::Type::String: dump_string(out, v.str); break;
+    case JsonValue::Type::Array:
+        if (v.items.empty()) { out += "[]"; break; }
+        out += '[';
+        for (size_t i = 0; i < v.items.size(); ++i) {
+            if (i) out += ',';
+            newline(level + 1);
+            dump(out, v.items[i], indent, level + 1);
+        }
+        newline(level);
+        out += ']';
+        break;
+    case JsonValue::Type::Object:
+        if (v.members.empty()) { out += "{}"; break; }
+        out += '{';
+        for (size_t i = 0; i < v.members.size(); ++i) {
+            if (i) out += ',';
+            newline(level + 1);
+            dump_string(out, v.members[i].first);
+            out += ": ";
+            dump(out, v.members[i].second, indent, level + 1);
+        }
+        newline(level);
+        out += '}';
+        break;
+    }
+}
+
+} // namespace
+
+const JsonValue *JsonValue::find(const std::string &key) const {
+    if (type != Type::Object) return nullptr;
+    for (const auto &m : members)
+        if (m.first == key) return &m.second;
+    return nullptr;
+}
+
+JsonValue json_parse(const std::string &text) {
+    if (!valid_utf8(text)) throw std::runtime_error("input is not valid UTF-8");
+    return Parser(text).document();
+}
+
+std::string json_dump(const JsonValue &v, int indent) {
+    std::string out;
+    dump(out, v, indent, 0);
+    return out;
+}
+
+} // namespace oksi
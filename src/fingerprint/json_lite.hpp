@@ -0,0 +1,43 @@
+// Minimal JSON (C++)
+// ---------------------------------
+// Purpose:
+//   Just enough JSON for oksi_verify: parse the machine-file envelope and
+//   decrypted payload, and pretty-print the payload byte-for-byte like
+//   Python's json.dumps(obj, indent=2) so the native verifier's output is a
+//   drop-in match for verify_machine_file.py.
+//
+// Semantics (mirroring Python's json module):
+//   - Object members keep first-seen order; a duplicate key replaces the
+//     earlier value in place.
+//   - Non-ASCII output is escaped as \uXXXX (ensure_ascii=True).
+//   - Integers are printed as parsed; other numbers use Python float repr.
+//   - NaN, Infinity and -Infinity are accepted, as Python does.
+
+#pragma once
+
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace oksi {
+
+struct JsonValue {
+    enum class Type { Null, Bool, Number, String, Array, Object };
+
+    Type type = Type::Null;
+    bool boolean = false;
+    std::string str;  // String: decoded UTF-8; Number: source token
+    std::vector<JsonValue> items;
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    // Object member lookup; nullptr if absent or not an object.
+    const JsonValue *find(const std::string &key) const;
+};
+
+// Parse a complete JSON document; throws std::runtime_error on bad input.
+JsonValue json_parse(const std::string &text);
+
+// Render like Python json.dumps(v, indent=indent).
+std::string json_dump(const JsonValue &v, int indent = 2);
+
+} // namespace oksi
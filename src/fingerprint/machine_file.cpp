@@ -0,0 +1,267 @@
+// Keygen Machine/License Files (C++)
+// ---------------------------------
+// See machine_file.hpp; each function follows its keygen_crypto.py namesake.
+
+#include "machine_file.hpp"
+
+#include "crypto.hpp"
+#include "sha256.hpp"
+
+#include <cstring>
+
+namespace oksi {
+
+namespace {
+
+// Python str.strip() whitespace for the ASCII range.
+bool is_space(unsigned char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r') || (c >= 0x1c && c <= 0x1f);
+}
+
+std::string strip(const std::string &s) {
+    size_t b = 0, e = s.size();
+    while (b < e && is_space(static_cast<unsigned char>(s[b]))) ++b;
+    while (e > b && is_space(static_cast<unsigned char>(s[e - 1]))) --e;
+    return s.substr(b, e - b);
+}
+
+// Python str.splitlines() for the ASCII line boundaries.
+std::vector<std::string> split_lines(const std::string &s) {
+    std::vector<std::string> lines;
+    size_t start = 0;
+    for (size_t i = 0; i < s.size(); ++i) {
+        const char c = s[i];
+        if (c == '\n' || c == '\r' || c == '\v' || c == '\f' || (c >= 0x1c && c <= 0x1e)) {
+            lines.push_back(s.substr(start, i - start));
+            if (c == '\r' && i + 1 < s.size() && s[i + 1] == '\n') ++i;
+            start = i + 1;
+        }
+    }
+    if (start < s.size()) lines.push_back(s.substr(start));
+    return lines;
+}
+
+int b64_value(unsigned char c) {
+    if (c >= 'A' && c <= 'Z') return c - 'A';
+    if (c >= 'a' && c <= 'z') return c - 'a' + 26;
+    if (c >= '0' && c <= '9') return c - '0' + 52;
+    if (c == '+') return 62;
+    if (c == '/') return 63;
+    return -1;
+}
+
+// binascii.a2b_base64 with and without strict_mode.
+bool a2b_base64(const std::string &s, bool strict, std::vector<uint8_t> &out) {
+    out.clear();
+    if (strict && !s.empty() && s[0] == '=') return false;
+    int quad = 0, pads = 0;
+    bool padding = false;
+    unsigned left = 0;
+    for (size_t i = 0; i < s.size(); ++i) {
+        const unsigned char c = static_cast<unsigned char>(s[i]);
+        if (c == '=') {
+            padding = true;
+            if (strict && quad == 0) return false;
+            if (quad >= 2 && quad + ++pads >= 4) {
+                if (strict && i + 1 < s.size()) return false;
+                return true;
+            }
+            continue;
+        }
+        const int v = b64_value(c);
+        if (v < 0) {
+            if (strict) return false;
+            continue;
+        }
+        if (strict && padding) return false;
+        pads = 0;
+        switch (quad) {
+        case 0: left = unsigned(v); quad = 1; break;
+        case 1: out.push_back(uint8_t((left << 2) | (unsigned(v) >> 4))); left = unsigned(v) & 0x0f; quad = 2; break;
+        case 2: out.push_back(uint8_t((left << 4) | (unsigned(v) >> 2))); left = unsigned(v) & 0x03; quad = 3; break;
+        default: out.push_back(uint8_t((left << 6) | unsigned(v))); quad = 0; break;
+        }
+    }
+    return quad == 0;
+}
+
+// bytes.fromhex(): pairs of hex digits, ASCII whitespace allowed between pairs.
+// Returns the offending character position (as Python reports it, i.e. in code
+// points) on failure, std::string::npos on success.
+size_t from_hex(const std::string &s, std::vector<uint8_t> &out) {
+    auto nib = [](char c) {
+        if (c >= '0' && c <= '9') return c - '0';
+        if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+        if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+        return -1;
+    };
+    auto position = [&s](size_t byte_off) {
+        size_t n = 0;
+        for (size_t i = 0; i < byte_off; ++i)
+            if ((static_cast<unsigned char>(s[i]) & 0xC0) != 0x80) ++n;
+        return n;
+    };
+    out.clear();
+    for (size_t i = 0; i < s.size();) {
+        if (is_space(static_cast<unsigned char>(s[i]))) { ++i; continue; }
+        if (nib(s[i]) < 0) return position(i);
+        if (i + 1 >= s.size() || nib(s[i + 1]) < 0) return position(i + 1);
+        out.push_back(uint8_t(nib(s[i]) * 16 + nib(s[i + 1])));
+        i += 2;
+    }
+    return std::string::npos;
+}
+
+JsonValue parse_json_bytes(const std::vector<uint8_t> &bytes) {
+    return json_parse(std::string(bytes.begin(), bytes.end()));
+}
+
+} // namespace
+
+std::vector<uint8_t> b64_any_decode(const std::string &s) {
+    for (unsigned char c : s) {
+        if (c >= 0x80) throw std::invalid_argument("invalid base64 encoding");
+    }
+    std::string padded = s;
+    padded.append((4 - s.size() % 4) % 4, '=');
+    std::vector<uint8_t> out;
+    if (a2b_base64(padded, true, out)) return out;
+    for (char &c : padded) {
+        if (c == '-') c = '+';
+        else if (c == '_') c = '/';
+    }
+    if (a2b_base64(padded, false, out)) return out;
+    throw std::invalid_argument("invalid base64 encoding");
+}
+
+Certificate parse_certificate(const std::string &text) {
+    const std::vector<std::string> lines = split_lines(text);
+    if (lines.empty()) throw LicenseFileError("empty certificate");
+
+    static const std::string kBegin = "-----BEGIN ", kEnd = " FILE-----";
+    const std::string first = strip(lines.front());
+    if (first.compare(0, kBegin.size(), kBegin) != 0 || first.size() < kEnd.size() ||
+        first.compare(first.size() - kEnd.size(), kEnd.size(), kEnd) != 0)
+        throw LicenseFileError("malformed certificate header");
+    Certificate cert;
+    if (first.size() > kBegin.size() + kEnd.size())
+        cert.kind = strip(first.substr(kBegin.size(), first.size() - kBegin.size() - kEnd.size()));
+    if (cert.kind != "LICENSE" && cert.kind != "MACHINE")
+        throw LicenseFileError("unsupported certificate kind: " + cert.kind);
+
+    if (lines.size() < 2 || strip(lines.back()) != "-----END " + cert.kind + " FILE-----")
+        throw LicenseFileError("malformed certificate footer");
+
+    std::string inner;
+    for (size_t i = 1; i + 1 < lines.size(); ++i) inner += strip(lines[i]);
+
+    std::vector<uint8_t> decoded;
+    try {
+        decoded = b64_any_decode(inner);
+    } catch (const std::exception &) {
+        throw LicenseFileError("invalid base64 payload");
+    }
+
+    JsonValue obj;
+    try {
+        obj = parse_json_bytes(decoded);
+    } catch (const std::exception &) {
+        throw LicenseFileError("invalid JSON payload");
+    }
+
+    for (const char *k : {"enc", "alg", "sig"}) {
+        if (!obj.find(k)) throw LicenseFileError(std::string("certificate missing '") + k + "'");
+    }
+    const JsonValue *alg = obj.find("alg");
+    const JsonValue *enc = obj.find("enc");
+    const JsonValue *sig = obj.find("sig");
+    if (alg->type != JsonValue::Type::String || enc->type != JsonValue::Type::String ||
+        (sig->type != JsonValue::Type::Null && sig->type != JsonValue::Type::String))
+        throw LicenseFileError("invalid certificate fields");
+
+    cert.alg = alg->str;
+    cert.enc = enc->str;
+    cert.has_sig = sig->type == JsonValue::Type::String;
+    if (cert.has_sig) cert.sig = sig->str;
+    return cert;
+}
+
+void verify_signature(const Certificate &cert, const std::string &public_key_hex) {
+    if (public_key_hex.empty() || !cert.has_sig || cert.sig.empty()) return;
+
+    std::vector<uint8_t> pk;
+    const size_t bad = from_hex(public_key_hex, pk);
+    if (bad != std::string::npos)
+        throw SignatureError("non-hexadecimal number found in fromhex() arg at position " + std::to_string(bad));
+    if (pk.size() != 32) throw SignatureError("An Ed25519 public key is 32 bytes long");
+
+    std::vector<uint8_t> sig;
+    try {
+        sig = b64_any_decode(cert.sig);
+    } catch (const std::invalid_argument &e) {
+        throw SignatureError(e.what());
+    }
+
+    std::string kind = cert.kind;
+    for (char &c : kind) c = char(c - 'A' + 'a');
+    const std::string message = kind + "/" + cert.enc;
+    if (sig.size() != 64 ||
+        !ed25519_verify(sig.data(), reinterpret_cast<const uint8_t *>(message.data()), message.size(), pk.data()))
+        throw SignatureError(""); // cryptography's InvalidSignature carries no message
+}
+
+JsonValue decrypt_payload(const Certificate &cert, const std::string &license_key,
+                          const std::string &machine_fingerprint) {
+    const std::string &alg = cert.alg;
+    if (alg.compare(0, 11, "aes-256-gcm") == 0) {
+        std::string secret_material;
+        if (cert.kind == "LICENSE") {
+            secret_material = license_key;
+        } else if (cert.kind == "MACHINE") {
+            if (machine_fingerprint.empty())
+                throw LicenseFileError("machine_fingerprint is required to decrypt a MACHINE file");
+            secret_material = license_key + machine_fingerprint;
+        } else {
+            throw LicenseFileError("Unknown certificate kind: " + cert.kind);
+        }
+
+        SHA256 h;
+        h.update(secret_material);
+        const std::array<uint8_t,32> secret = h.digest();
+
+        // enc = b64(ciphertext) . b64(iv_12B) . b64(tag_16B)
+        const size_t d1 = cert.enc.find('.');
+        const size_t d2 = d1 == std::string::npos ? d1 : cert.enc.find('.', d1 + 1);
+        if (d2 == std::string::npos || cert.enc.find('.', d2 + 1) != std::string::npos)
+            throw LicenseFileError("encrypted 'enc' format is invalid (expect 3 dot-separated parts)");
+        std::vector<uint8_t> ct, iv, tag;
+        try {
+            ct = b64_any_decode(cert.enc.substr(0, d1));
+            iv = b64_any_decode(cert.enc.substr(d1 + 1, d2 - d1 - 1));
+            tag = b64_any_decode(cert.enc.substr(d2 + 1));
+        } catch (const std::exception &) {
+            throw LicenseFileError("invalid base64 in encrypted 'enc' parts");
+        }
+        if (iv.size() != 12) throw LicenseFileError("invalid AES-GCM IV length (expected 12 bytes)");
+        if (tag.size() != 16) throw LicenseFileError("invalid AES-GCM tag length (expected 16 bytes)");
+
+        std::vector<uint8_t> plaintext;
+        if (!aes256_gcm_decrypt(secret.data(), iv.data(), ct.data(), ct.size(), tag.data(), plaintext))
+            throw LicenseFileError("AES-GCM decryption failed");
+        try {
+            return parse_json_bytes(plaintext);
+        } catch (const std::exception &) {
+            throw LicenseFileError("decrypted payload is not valid UTF-8 JSON");
+        }
+    }
+    if (alg.compare(0, 7, "base64+") == 0) {
+        try {
+            return parse_json_bytes(b64_any_decode(cert.enc));
+        } catch (const std::exception &) {
+            throw LicenseFileError("invalid base64/JSON payload");
+        }
+    }
+    throw UnsupportedAlgorithmError("Unsupported algorithm: " + alg);
+}
+
+} // namespace oksi
@@ -0,0 +1,71 @@
+// Keygen Machine/License Files (C++)
+// ---------------------------------
+// Purpose:
+//   Native counterpart of parse_certificate, verify_signature and
+//   decrypt_payload in src/sw-licensing/keygen_crypto.py, used by oksi_verify.
+//   Behavior (accepted inputs, error messages) mirrors the Python helpers so
+//   either verifier can be used against the same files.
+//
+// File format:
+//   -----BEGIN MACHINE FILE-----        (or LICENSE)
+//   base64({"enc": ..., "sig": ..., "alg": ...})
+//   -----END MACHINE FILE-----
+//
+//   "sig" is an Ed25519 signature over "<kind lowercase>/<enc>". For
+//   "aes-256-gcm+ed25519", enc is b64(ciphertext).b64(iv).b64(tag) under
+//   SHA-256(license key [+ fingerprint for MACHINE files]); for
+//   "base64+ed25519" it is the base64 JSON payload.
+
+#pragma once
+
+#include "json_lite.hpp"
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace oksi {
+
+class LicenseFileError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+class UnsupportedAlgorithmError : public LicenseFileError {
+public:
+    using LicenseFileError::LicenseFileError;
+};
+
+// Signature mismatch or unusable key/signature encoding.
+class SignatureError : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+struct Certificate {
+    std::string kind;  // "LICENSE" or "MACHINE"
+    std::string alg;   // e.g. "aes-256-gcm+ed25519" or "base64+ed25519"
+    std::string enc;   // encrypted or base64 payload
+    std::string sig;   // base64 signature over "<kind lowercase>/<enc>"
+    bool has_sig = false;
+};
+
+// Decode standard or URL-safe base64, tolerating missing padding: a strict
+// standard-alphabet pass first, then a lenient URL-safe pass that skips
+// foreign characters (Python base64 semantics). Throws std::invalid_argument.
+std::vector<uint8_t> b64_any_decode(const std::string &s);
+
+// Parse the armored file text; throws LicenseFileError.
+Certificate parse_certificate(const std::string &text);
+
+// Verify the Ed25519 signature if both a key (hex) and a signature are
+// present; a no-op otherwise. Throws SignatureError.
+void verify_signature(const Certificate &cert, const std::string &public_key_hex);
+
+// Decrypt/decode the payload JSON; throws LicenseFileError (or
+// UnsupportedAlgorithmError for an unknown alg).
+JsonValue decrypt_payload(const Certificate &cert, const std::string &license_key,
+                          const std::string &machine_fingerprint);
+
+} // namespace oksi
@@ -0,0 +1,146 @@
+// Fingerprint Library (C++)
+// ---------------------------------
+// Purpose:
+//   Implements the fingerprint derivation shared by the oksi_fingerprint CLI
+//   and the liboksi_fingerprint shared/static libraries, plus the extern "C"
+//   wrappers declared in oksi_fingerprint.h.
+//
+// Derivation:
+//   1) "mid:<machine-id>" if a machine id is present.
+//   2) "salt:<salt>" if a salt is provided.
+//   3) Join present parts with '|', SHA-256, base64-url encode without '='.
+
+#include "oksi_fingerprint.h"
+
+#include "fingerprint_core.hpp"
+#include "sha256.hpp"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace oksi {
+
+std::string trim(const std::string &s) {
+    size_t start = 0;
+    while (start < s.size() && (s[start] == ' ' || s[start] == '\n' || s[start] == '\r' || s[start] == '\t')) start++;
+    size_t end = s.size();
+    while (end > start && (s[end-1] == ' ' || s[end-1] == '\n' || s[end-1] == '\r' || s[end-1] == '\t')) end--;
+    return s.substr(start, end - start);
+}
+
+std::string read_file(const std::string &path) {
+    std::ifstream f(path);
+    if (!f.good()) return std::string();
+    std::ostringstream ss;
+    ss << f.rdbuf();
+    return trim(ss.str());
+}
+
+std::string fingerprint_input(const std::string &machine_id, const std::string &salt) {
+    // Collect input components (present parts only)
+    std::vector<std::string> parts;
+    if (!machine_id.empty()) {
+        parts.push_back(std::string("mid:") + machine_id);
+    }
+    if (!salt.empty()) {
+        parts.push_back(std::string("salt:") + salt);
+    }
+    // Join components with '|' in a stable format
+    std::string joined;
+    for (size_t i = 0; i < parts.size(); ++i) {
+        if (i) joined.push_back('|');
+        joined += parts[i];
+    }
+    return joined;
+}
+
+std::string compute_fingerprint(const std::string &machine_id, const std::string &salt) {
+    // Hash then encode in URL-safe base64 (no padding)
+    SHA256 sha;
+    sha.update(fingerprint_input(machine_id, salt));
+    auto dig = sha.digest();
+    return base64_urlsafe_nopad(dig.data(), dig.size());
+}
+
+FingerprintPrefix::FingerprintPrefix(const std::string &machine_id)
+    : m_unsalted(compute_fingerprint(machine_id, "")) {
+    // Same layout as fingerprint_input() with a non-empty salt
+    if (!machine_id.empty()) {
+        m_salted.update("mid:");
+        m_salted.update(machine_id);
+        m_salted.update("|");
+    }
+    m_salted.update("salt:");
+}
+
+std::string FingerprintPrefix::derive(const std::string &salt) const {
+    if (salt.empty()) return m_unsalted;
+    SHA256 sha = m_salted.clone();
+    sha.update(salt);
+    auto dig = sha.digest();
+    return base64_urlsafe_nopad(dig.data(), dig.size());
+}
+
+} // namespace oksi
+
+namespace {
+
+// Copy a computed fingerprint into a caller buffer, NUL-terminated.
+int copy_out(const std::string &fp, char *out, size_t cap) {
+    if (cap < fp.size() + 1) return OKSI_FP_ERANGE;
+    std::memcpy(out, fp.data(), fp.size());
+    out[fp.size()] = '\0';
+    return OKSI_FP_OK;
+}
+
+} // namespace
+
+extern "C" {
+
+int oksi_fingerprint(const char *salt, const char *mid_path, char *out, size_t cap) {
+    if (!out) return OKSI_FP_EINVAL;
+    if (cap < OKSI_FINGERPRINT_LEN + 1) return OKSI_FP_ERANGE;
+    try {
+        std::string path = (mid_path && *mid_path) ? mid_path : oksi::kDefaultMachineIdPath;
+        std::string machine_id = oksi::read_file(path);
+        return copy_out(oksi::compute_fingerprint(machine_id, salt ? salt : ""), out, cap);
+    } catch (...) {
+        return OKSI_FP_ENOMEM;
+    }
+}
+
+int oksi_fingerprint_from_machine_id(const char *machine_id, const char *salt, char *out, size_t cap) {
+    if (!out) return OKSI_FP_EINVAL;
+    if (cap < OKSI_FINGERPRINT_LEN + 1) return OKSI_FP_ERANGE;
+    try {
+        std::string mid = machine_id ? oksi::trim(machine_id) : std::string();
+        return copy_out(oksi::compute_fingerprint(mid, salt ? salt : ""), out, cap);
+    } catch (...) {
+        return OKSI_FP_ENOMEM;
+    }
+}
+
+int oksi_fingerprint_salts(const char *mid_path, const char *const *salts, size_t count, char *out, size_t stride) {
+    if (!out || (!salts && count)) return OKSI_FP_EINVAL;
+    if (stride < OKSI_FINGERPRINT_LEN + 1) return OKSI_FP_ERANGE;
+    try {
+        std::string path = (mid_path && *mid_path) ? mid_path : oksi::kDefaultMachineIdPath;
+        const oksi::FingerprintPrefix prefix(oksi::read_file(path));
+        for (size_t i = 0; i < count; ++i) {
+            int rc = copy_out(prefix.derive(salts[i] ? salts[i] : ""), out + i * stride, stride);
+            if (rc != OKSI_FP_OK) return rc;
+        }
+        return OKSI_FP_OK;
+    } catch (...) {
+        return OKSI_FP_ENOMEM;
+    }
+}
+
+const char *oksi_fingerprint_version(void) {
+    return OKSI_FINGERPRINT_VERSION;
+}
+
+} // extern "C"
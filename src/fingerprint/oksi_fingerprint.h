@@ -0,0 +1,75 @@
+/* OKSI Fingerprint Library (C ABI)
+ * ---------------------------------
+ * Purpose:
+ *   Stable C interface to the fingerprint derivation used by the
+ *   oksi_fingerprint helper, so callers (e.g. Python via ctypes) can compute
+ *   fingerprints in-process instead of spawning the executable.
+ *
+ * Output format:
+ *   URL-safe base64 (no padding) of SHA-256("mid:<machine-id>|salt:<salt>"),
+ *   omitting absent parts exactly like the CLI does. Always
+ *   OKSI_FINGERPRINT_LEN characters plus a terminating NUL.
+ *
+ * Return codes:
+ *   OKSI_FP_OK (0) on success, a negative OKSI_FP_E* value otherwise.
+ *   No C++ exception ever crosses this interface.
+ */
+
+#ifndef OKSI_FINGERPRINT_H
+#define OKSI_FINGERPRINT_H
+
+#include <stddef.h>
+
+#if defined(_WIN32)
+#  if defined(OKSI_FP_BUILDING_SHARED)
+#    define OKSI_FP_API __declspec(dllexport)
+#  elif defined(OKSI_FP_USING_SHARED)
+#    define OKSI_FP_API __declspec(dllimport)
+#  else
+#    define OKSI_FP_API
+#  endif
+#else
+#  define OKSI_FP_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* Length of an encoded fingerprint, excluding the terminating NUL. */
+#define OKSI_FINGERPRINT_LEN 43
+
+#define OKSI_FP_OK        0
+#define OKSI_FP_EINVAL   -1 /* out (or salts) is NULL */
+#define OKSI_FP_ERANGE   -2 /* cap/stride < OKSI_FINGERPRINT_LEN + 1 */
+#define OKSI_FP_ENOMEM   -3 /* allocation or other internal failure */
+
+/* Compute the fingerprint for the machine id read from mid_path.
+ *   salt      optional scope salt; NULL or "" omits the salt part
+ *   mid_path  machine-id file; NULL or "" means /etc/machine-id. A missing or
+ *             unreadable file omits the mid part (same as the CLI).
+ *   out/cap   destination buffer, NUL-terminated on success
+ */
+OKSI_FP_API int oksi_fingerprint(const char *salt, const char *mid_path, char *out, size_t cap);
+
+/* Same as oksi_fingerprint() but takes the machine id value directly.
+ * machine_id is trimmed of surrounding whitespace; NULL or "" omits it. */
+OKSI_FP_API int oksi_fingerprint_from_machine_id(const char *machine_id, const char *salt, char *out, size_t cap);
+
+/* Fingerprints for several salts under the machine id read from mid_path
+ * (same rules as oksi_fingerprint()); the machine-id prefix is hashed once.
+ *   salts      count salts; a NULL or "" entry omits the salt part
+ *   out/stride count NUL-terminated results written stride bytes apart,
+ *              stride >= OKSI_FINGERPRINT_LEN + 1
+ */
+OKSI_FP_API int oksi_fingerprint_salts(const char *mid_path, const char *const *salts, size_t count,
+                                       char *out, size_t stride);
+
+/* Library version string, e.g. "1.0.0". */
+OKSI_FP_API const char *oksi_fingerprint_version(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* OKSI_FINGERPRINT_H */
@@ -0,0 +1,115 @@
+// Machine File Verifier (C++)
+// ---------------------------------
+// Purpose:
+//   Native replacement for src/sw-licensing/verify_machine_file.py: check a
+//   Keygen machine file's Ed25519 signature, decrypt (or decode) its payload
+//   and print it, without starting a Python interpreter.
+//
+// Usage:
+//   ./oksi_verify --path machine.lic --license-key <key> --pubkey <hex>
+//                 [--fingerprint <fp>]
+//
+//   --fingerprint defaults to this host's fingerprint (same derivation as
+//   oksi_fingerprint with no salt).
+//
+// Output and exit status match the Python script: "[info] ..." progress
+// lines and the payload as json.dumps(indent=2) on stdout, or an
+// "[error] ..." line and exit code 1; missing required options exit 2.
+
+#include "fingerprint_core.hpp"
+#include "machine_file.hpp"
+
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+static const char *kUsage =
+    "usage: oksi_verify --path PATH --license-key LICENSE_KEY --pubkey PUBKEY [--fingerprint FINGERPRINT]\n";
+
+// Python str.rstrip() for the ASCII range.
+static std::string rstrip(std::string s) {
+    while (!s.empty() && (s.back() == ' ' || (s.back() >= '\t' && s.back() <= '\r') ||
+                          (s.back() >= 0x1c && s.back() <= 0x1f)))
+        s.pop_back();
+    return s;
+}
+
+int main(int argc, char** argv) {
+    // Parse arguments:
+    //   --path <file> (required)
+    //   --license-key <key> (required)
+    //   --pubkey <hex> (required; Ed25519 public key)
+    //   --fingerprint <fp> (default: this host's fingerprint)
+    std::string path, license_key, pubkey, fingerprint;
+    bool have_path = false, have_key = false, have_pubkey = false, have_fp = false;
+    for (int i = 1; i < argc; ++i) {
+        std::string a = argv[i];
+        if (a == "-h" || a == "--help") {
+            std::cout << kUsage;
+            return 0;
+        } else if (a == "--path" && i + 1 < argc) {
+            path = argv[++i];
+            have_path = true;
+        } else if (a == "--license-key" && i + 1 < argc) {
+            license_key = argv[++i];
+            have_key = true;
+        } else if (a == "--pubkey" && i + 1 < argc) {
+            pubkey = argv[++i];
+            have_pubkey = true;
+        } else if (a == "--fingerprint" && i + 1 < argc) {
+            fingerprint = argv[++i];
+            have_fp = true;
+        } else {
+            std::cerr << kUsage << "oksi_verify: error: unrecognized or incomplete argument: " << a << std::endl;
+            return 2;
+        }
+    }
+    if (!have_path || !have_key || !have_pubkey) {
+        std::cerr << kUsage << "oksi_verify: error: --path, --license-key and --pubkey are required" << std::endl;
+        return 2;
+    }
+    if (!have_fp) fingerprint = oksi::compute_fingerprint(oksi::read_file(oksi::kDefaultMachineIdPath), "");
+
+    // Read the machine file
+    std::ifstream f(path, std::ios::binary);
+    if (!f.good()) {
+        const int err = errno;
+        std::cout << "[error] path does not exist or permission denied: [Errno " << err << "] "
+                  << std::strerror(err) << ": '" << path << "'" << std::endl;
+        return 1;
+    }
+    std::ostringstream ss;
+    ss << f.rdbuf();
+    const std::string machine_file = rstrip(ss.str());
+
+    oksi::Certificate cert;
+    try {
+        cert = oksi::parse_certificate(machine_file);
+    } catch (const std::exception &e) {
+        std::cout << "[error] failed to parse machine file certificate: " << e.what() << std::endl;
+        return 1;
+    }
+
+    try {
+        oksi::verify_signature(cert, pubkey);
+    } catch (const std::exception &e) {
+        std::cout << "[error] certificate signature verification failed: " << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "[info] certificate signature verification successful!" << std::endl;
+
+    oksi::JsonValue payload;
+    try {
+        payload = oksi::decrypt_payload(cert, license_key, fingerprint);
+    } catch (const std::exception &e) {
+        std::cout << "[error] decryption failed: " << e.what() << std::endl;
+        return 1;
+    }
+    std::cout << "[info] decryption successful!" << std::endl;
+    std::cout << oksi::json_dump(payload, 2) << std::endl;
+    return 0;
+}
@@ -0,0 +1,389 @@
+// SHA-256 and Base64 primitives (C++)
+// ---------------------------------
+// Purpose:
+//   Self-contained building blocks shared by the fingerprint library, the
+//   CLI helper and its tests; no external dependencies. The SHA256 class is
+//   header-only, while the compression backends (portable, x86 SHA-NI, ARMv8
+//   SHA2) are chosen at runtime by sha256_dispatch.cpp.
+//
+// Compile-time use:
+//   SHA256 and the base64 encoder are also usable in constant expressions
+//   (see fingerprint_constexpr.hpp). During constant evaluation SHA256 runs
+//   the portable compression function; at runtime it still goes through the
+//   dispatcher. OKSI_HAVE_CONSTEXPR_SHA256 is 0 on compilers that cannot tell
+//   the two apart, in which case SHA256 is runtime-only.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+// Constant-evaluation check: std::is_constant_evaluated() under C++20, the
+// equivalent builtin (GCC >= 9, Clang >= 9, MSVC >= 19.25) under C++17.
+#if defined(__cpp_lib_is_constant_evaluated)
+#  define OKSI_SHA256_IS_CONSTANT_EVALUATED() std::is_constant_evaluated()
+#elif defined(__has_builtin)
+#  if __has_builtin(__builtin_is_constant_evaluated)
+#    define OKSI_SHA256_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#  endif
+#endif
+#if !defined(OKSI_SHA256_IS_CONSTANT_EVALUATED) && \
+    ((defined(__GNUC__) && !defined(__clang__) && __GNUC__ >= 9) || (defined(_MSC_VER) && _MSC_VER >= 1925))
+#  define OKSI_SHA256_IS_CONSTANT_EVALUATED() __builtin_is_constant_evaluated()
+#endif
+
+#if defined(OKSI_SHA256_IS_CONSTANT_EVALUATED)
+#  define OKSI_HAVE_CONSTEXPR_SHA256 1
+#  define OKSI_SHA256_CONSTEXPR constexpr
+#else
+#  define OKSI_HAVE_CONSTEXPR_SHA256 0
+#  define OKSI_SHA256_CONSTEXPR
+#  define OKSI_SHA256_IS_CONSTANT_EVALUATED() false
+#endif
+
+namespace oksi {
+
+// Compression-function plumbing shared by SHA256 and the hardware backends.
+namespace sha256_detail {
+
+// SHA-256 round constants (first 32 bits of the fractional parts of the cube
+// roots of the first 64 primes).
+inline constexpr uint32_t K[64] = {
+    0x428a2f98,0x71374491,0xb5c0fbcf,0xe9b5dba5,0x3956c25b,0x59f111f1,0x923f82a4,0xab1c5ed5,
+    0xd807aa98,0x12835b01,0x243185be,0x550c7dc3,0x72be5d74,0x80deb1fe,0x9bdc06a7,0xc19bf174,
+    0xe49b69c1,0xefbe4786,0x0fc19dc6,0x240ca1cc,0x2de92c6f,0x4a7484aa,0x5cb0a9dc,0x76f988da,
+    0x983e5152,0xa831c66d,0xb00327c8,0xbf597fc7,0xc6e00bf3,0xd5a79147,0x06ca6351,0x14292967,
+    0x27b70a85,0x2e1b2138,0x4d2c6dfc,0x53380d13,0x650a7354,0x766a0abb,0x81c2c92e,0x92722c85,
+    0xa2bfe8a1,0xa81a664b,0xc24b8b70,0xc76c51a3,0xd192e819,0xd6990624,0xf40e3585,0x106aa070,
+    0x19a4c116,0x1e376c08,0x2748774c,0x34b0bcb5,0x391c0cb3,0x4ed8aa4a,0x5b9cca4f,0x682e6ff3,
+    0x748f82ee,0x78a5636f,0x84c87814,0x8cc70208,0x90befffa,0xa4506ceb,0xbef9a3f7,0xc67178f2
+};
+
+// SHA-256 helper functions (bitwise primitives defined by the spec)
+constexpr uint32_t rotr(uint32_t x, uint32_t n) { return (x >> n) | (x << (32 - n)); }
+constexpr uint32_t ch(uint32_t x, uint32_t y, uint32_t z) { return (x & y) ^ (~x & z); }
+constexpr uint32_t maj(uint32_t x, uint32_t y, uint32_t z) { return (x & y) ^ (x & z) ^ (y & z); }
+constexpr uint32_t ep0(uint32_t x) { return rotr(x,2) ^ rotr(x,13) ^ rotr(x,22); }
+constexpr uint32_t ep1(uint32_t x) { return rotr(x,6) ^ rotr(x,11) ^ rotr(x,25); }
+constexpr uint32_t sig0(uint32_t x) { return rotr(x,7) ^ rotr(x,18) ^ (x >> 3); }
+constexpr uint32_t sig1(uint32_t x) { return rotr(x,17) ^ rotr(x,19) ^ (x >> 10); }
+
+// Compress nblocks consecutive 64-byte blocks from data into state.
+using CompressFn = void (*)(uint32_t state[8], const uint8_t *data, size_t nblocks);
+
+// Portable scalar compression; the reference and fallback for all backends,
+// and the implementation used during constant evaluation.
+constexpr void compress_portable(uint32_t state[8], const uint8_t *data, size_t nblocks) {
+    for (; nblocks; --nblocks, data += 64) {
+        uint32_t m[64] = {};
+        // Prepare message schedule m[0..63]
+        for (uint32_t i = 0, j = 0; i < 16; ++i, j += 4)
+            m[i] = (uint32_t(data[j]) << 24) | (uint32_t(data[j+1]) << 16) | (uint32_t(data[j+2]) << 8) | data[j+3];
+        for (uint32_t i = 16; i < 64; ++i)
+            m[i] = sig1(m[i-2]) + m[i-7] + sig0(m[i-15]) + m[i-16];
+
+        // Initialize working variables with current state
+        uint32_t a = state[0];
+        uint32_t b = state[1];
+        uint32_t c = state[2];
+        uint32_t d = state[3];
+        uint32_t e = state[4];
+        uint32_t f = state[5];
+        uint32_t g = state[6];
+        uint32_t h = state[7];
+
+        // 64 rounds of mixing with constants and schedule
+        for (uint32_t i = 0; i < 64; ++i) {
+            uint32_t t1 = h + ep1(e) + ch(e,f,g) + K[i] + m[i];
+            uint32_t t2 = ep0(a) + maj(a,b,c);
+            h = g; g = f; f = e; e = d + t1; d = c; c = b; b = a; a = t1 + t2;
+        }
+
+        // Add the compressed chunk to the current hash value
+        state[0] += a;
+        state[1] += b;
+        state[2] += c;
+        state[3] += d;
+        state[4] += e;
+        state[5] += f;
+        state[6] += g;
+        state[7] += h;
+    }
+}
+
+// Hardware backends (sha256_x86.cpp / sha256_arm.cpp). Only call these after
+// the dispatcher confirmed CPU support.
+void compress_shani(uint32_t state[8], const uint8_t *data, size_t nblocks);
+void compress_armv8(uint32_t state[8], const uint8_t *data, size_t nblocks);
+
+// Exit status of the CLI and test executables when OKSI_SHA256_IMPL /
+// OKSI_SHA256_MB_IMPL force a backend the CPU cannot run (CTest
+// SKIP_RETURN_CODE). The library itself never exits.
+constexpr int kBackendUnavailableExit = 77;
+
+// Implementation selected once per process: the fastest backend the CPU
+// supports, unless OKSI_SHA256_IMPL=portable|shani|armv8 requests another
+// (unsupported requests are reported on stderr and get the fastest backend).
+CompressFn compress();
+
+// Name of the implementation returned by compress(), e.g. "shani".
+const char *compress_name();
+
+// "VAR=value" of an OKSI_SHA256_IMPL / OKSI_SHA256_MB_IMPL override this CPU
+// cannot honor, or nullptr when every override (if any) is satisfiable.
+const char *unavailable_backend_request();
+
+// Compress through the dispatcher at runtime, portably in constant evaluation.
+OKSI_SHA256_CONSTEXPR inline void compress_any(uint32_t state[8], const uint8_t *data, size_t nblocks) {
+    if (OKSI_SHA256_IS_CONSTANT_EVALUATED()) compress_portable(state, data, nblocks);
+    else compress()(state, data, nblocks);
+}
+
+// memcpy at runtime, a byte loop in constant evaluation.
+OKSI_SHA256_CONSTEXPR inline void copy_bytes(uint8_t *dst, const uint8_t *src, size_t n) {
+    if (OKSI_SHA256_IS_CONSTANT_EVALUATED()) {
+        for (size_t i = 0; i < n; ++i) dst[i] = src[i];
+    } else if (n) {
+        memcpy(dst, src, n);
+    }
+}
+
+} // namespace sha256_detail
+
+// Minimal SHA-256 implementation (no external deps).
+//
+// High-level overview of SHA-256:
+//   - Processes input in 512-bit (64-byte) chunks.
+//   - Maintains an internal 256-bit state (8 x 32-bit words).
+//   - Each chunk is expanded into a message schedule (64 x 32-bit words),
+//     then mixed through a compression function with round constants.
+//   - Final output is the 256-bit state after processing all chunks.
+//
+// Objects are plain values: copying one (or clone()) forks the hash, so a
+// shared prefix can be hashed once and finished with different suffixes. At a
+// block boundary the state can also be exported as a Midstate and imported
+// into another object, even in another process via to_bytes()/from_bytes().
+class SHA256 {
+public:
+    // Chaining state after a whole number of 64-byte blocks.
+    struct Midstate {
+        // Serialized size: eight big-endian state words, then the big-endian
+        // count of bytes hashed.
+        static constexpr size_t kBytes = 40;
+
+        uint32_t state[8] = {};
+        uint64_t length = 0;  // bytes hashed so far, a multiple of 64
+
+        constexpr std::array<uint8_t,kBytes> to_bytes() const {
+            std::array<uint8_t,kBytes> out{};
+            for (size_t i = 0; i < 8; ++i)
+                for (size_t j = 0; j < 4; ++j) out[4 * i + j] = static_cast<uint8_t>(state[i] >> (24 - 8 * j));
+            for (size_t j = 0; j < 8; ++j) out[32 + j] = static_cast<uint8_t>(length >> (56 - 8 * j));
+            return out;
+        }
+
+        // Whether length can be resumed: block-aligned, and small enough
+        // for the 64-bit message bit count.
+        constexpr bool valid() const { return length % 64 == 0 && length <= UINT64_MAX / 8; }
+
+        // Parse a to_bytes() image; false (and out untouched) on a wrong
+        // size or a length valid() rejects.
+        static constexpr bool from_bytes(const uint8_t *data, size_t len, Midstate &out) {
+            if (len != kBytes) return false;
+            Midstate st{};
+            for (size_t i = 0; i < 8; ++i) {
+                uint32_t w = 0;
+                for (size_t j = 0; j < 4; ++j) w = (w << 8) | data[4 * i + j];
+                st.state[i] = w;
+            }
+            for (size_t j = 0; j < 8; ++j) st.length = (st.length << 8) | data[32 + j];
+            if (!st.valid()) return false;
+            out = st;
+            return true;
+        }
+    };
+
+    OKSI_SHA256_CONSTEXPR SHA256() { reset(); }
+
+    // Initialize internal state and counters.
+    OKSI_SHA256_CONSTEXPR void reset() {
+        m_data_len = 0; m_bit_len = 0;
+        m_state[0] = 0x6a09e667;
+        m_state[1] = 0xbb67ae85;
+        m_state[2] = 0x3c6ef372;
+        m_state[3] = 0xa54ff53a;
+        m_state[4] = 0x510e527f;
+        m_state[5] = 0x9b05688c;
+        m_state[6] = 0x1f83d9ab;
+        m_state[7] = 0x5be0cd19;
+    }
+
+    // Feed arbitrary bytes into the hash. Tops up a partially filled block,
+    // compresses whole 64-byte blocks straight from the caller's buffer and
+    // only buffers the remaining tail.
+    OKSI_SHA256_CONSTEXPR void update(const uint8_t *data, size_t len) {
+        if (len == 0) return;
+        if (m_data_len) {
+            size_t take = 64 - m_data_len;
+            if (take > len) take = len;
+            sha256_detail::copy_bytes(m_data + m_data_len, data, take);
+            m_data_len += take;
+            data += take;
+            len -= take;
+            if (m_data_len < 64) return;
+            transform();
+            m_bit_len += 512;
+            m_data_len = 0;
+        }
+        size_t blocks = len / 64;
+        if (blocks) {
+            sha256_detail::compress_any(m_state, data, blocks);
+            m_bit_len += static_cast<uint64_t>(blocks) * 512;
+            data += blocks * 64;
+            len -= blocks * 64;
+        }
+        if (len) {
+            sha256_detail::copy_bytes(m_data, data, len);
+            m_data_len = static_cast<uint32_t>(len);
+        }
+    }
+    // Convenience overload for character input (std::string, literals). In
+    // constant evaluation the characters are buffered one at a time, since
+    // they cannot be reinterpreted as bytes there.
+    OKSI_SHA256_CONSTEXPR void update(std::string_view s) {
+        if (!OKSI_SHA256_IS_CONSTANT_EVALUATED()) {
+            update(reinterpret_cast<const uint8_t*>(s.data()), s.size());
+            return;
+        }
+        for (char c : s) {
+            m_data[m_data_len++] = static_cast<uint8_t>(c);
+            if (m_data_len == 64) {
+                transform();
+                m_bit_len += 512;
+                m_data_len = 0;
+            }
+        }
+    }
+
+    // Independent copy of the current hash state.
+    OKSI_SHA256_CONSTEXPR SHA256 clone() const { return *this; }
+
+    // True when no partial block is buffered, i.e. export_state() will succeed.
+    constexpr bool at_block_boundary() const { return m_data_len == 0; }
+
+    // Capture the state; false (and out untouched) if a partial block is
+    // buffered, since a Midstate carries no buffered bytes.
+    constexpr bool export_state(Midstate &out) const {
+        if (m_data_len != 0) return false;
+        for (size_t i = 0; i < 8; ++i) out.state[i] = m_state[i];
+        out.length = m_bit_len / 8;
+        return true;
+    }
+
+    // Resume from a Midstate; false (and state untouched) unless
+    // st.valid().
+    constexpr bool import_state(const Midstate &st) {
+        if (!st.valid()) return false;
+        for (size_t i = 0; i < 8; ++i) m_state[i] = st.state[i];
+        m_bit_len = st.length * 8;
+        m_data_len = 0;
+        return true;
+    }
+
+    // Finalize and return the 32-byte (256-bit) digest.
+    OKSI_SHA256_CONSTEXPR std::array<uint8_t,32> digest() {
+        std::array<uint8_t,32> hash{};
+        size_t i = m_data_len;
+
+        // Padding: append 0x80, then zeros, leaving 8 bytes for bit length
+        if (m_data_len < 56) {
+            m_data[i++] = 0x80;
+            while (i < 56) m_data[i++] = 0x00;
+        } else {
+            m_data[i++] = 0x80;
+            while (i < 64) m_data[i++] = 0x00;
+            transform();
+            for (i = 0; i < 56; ++i) m_data[i] = 0x00;
+        }
+        // Append total message length in bits (big-endian)
+        m_bit_len += m_data_len * 8;
+        m_data[63] = static_cast<uint8_t>(m_bit_len);
+        m_data[62] = static_cast<uint8_t>(m_bit_len >> 8);
+        m_data[61] = static_cast<uint8_t>(m_bit_len >> 16);
+        m_data[60] = static_cast<uint8_t>(m_bit_len >> 24);
+        m_data[59] = static_cast<uint8_t>(m_bit_len >> 32);
+        m_data[58] = static_cast<uint8_t>(m_bit_len >> 40);
+        m_data[57] = static_cast<uint8_t>(m_bit_len >> 48);
+        m_data[56] = static_cast<uint8_t>(m_bit_len >> 56);
+        transform();
+        // Convert internal state to big-endian byte array
+        for (i = 0; i < 4; ++i) {
+            hash[i]      = (m_state[0] >> (24 - i * 8)) & 0x000000ff;
+            hash[i + 4]  = (m_state[1] >> (24 - i * 8)) & 0x000000ff;
+            hash[i + 8]  = (m_state[2] >> (24 - i * 8)) & 0x000000ff;
+            hash[i + 12] = (m_state[3] >> (24 - i * 8)) & 0x000000ff;
+            hash[i + 16] = (m_state[4] >> (24 - i * 8)) & 0x000000ff;
+            hash[i + 20] = (m_state[5] >> (24 - i * 8)) & 0x000000ff;
+            hash[i + 24] = (m_state[6] >> (24 - i * 8)) & 0x000000ff;
+            hash[i + 28] = (m_state[7] >> (24 - i * 8)) & 0x000000ff;
+        }
+        return hash;
+    }
+
+private:
+    uint8_t m_data[64] = {};
+    uint32_t m_data_len = 0;
+    uint64_t m_bit_len = 0;
+    uint32_t m_state[8] = {};
+
+    // Core compression: processes the buffered 512-bit block with the
+    // implementation selected for this CPU (see sha256_dispatch.cpp).
+    OKSI_SHA256_CONSTEXPR void transform() { sha256_detail::compress_any(m_state, m_data, 1); }
+};
+
+// Base64 (URL-safe) alphabet.
+inline constexpr char kBase64UrlAlphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+// Encoded length of len bytes without '=' padding.
+constexpr size_t base64_urlsafe_nopad_len(size_t len) { return len / 3 * 4 + (len % 3 ? len % 3 + 1 : 0); }
+
+// Base64 (URL-safe) encoder without '=' padding into a caller buffer of at
+// least base64_urlsafe_nopad_len(len) chars; no NUL is written. Usable in
+// constant expressions.
+constexpr void base64_urlsafe_nopad(const uint8_t *data, size_t len, char *out) {
+    const char *tbl = kBase64UrlAlphabet;
+    size_t i = 0;
+    while (i + 3 <= len) {
+        uint32_t n = (uint32_t(data[i]) << 16) | (uint32_t(data[i+1]) << 8) | (data[i+2]);
+        i += 3;
+        *out++ = tbl[(n >> 18) & 63];
+        *out++ = tbl[(n >> 12) & 63];
+        *out++ = tbl[(n >> 6) & 63];
+        *out++ = tbl[n & 63];
+    }
+    size_t rem = len - i;
+    if (rem == 1) {
+        uint32_t n = (uint32_t(data[i]) << 16);
+        *out++ = tbl[(n >> 18) & 63];
+        *out++ = tbl[(n >> 12) & 63];
+    } else if (rem == 2) {
+        uint32_t n = (uint32_t(data[i]) << 16) | (uint32_t(data[i+1]) << 8);
+        *out++ = tbl[(n >> 18) & 63];
+        *out++ = tbl[(n >> 12) & 63];
+        *out++ = tbl[(n >> 6) & 63];
+    }
+}
+
+// Base64 (URL-safe) encoder without '=' padding.
+inline std::string base64_urlsafe_nopad(const uint8_t *data, size_t len) {
+    std::string out(base64_urlsafe_nopad_len(len), '\0');
+    base64_urlsafe_nopad(data, len, &out[0]);
+    return out;
+}
+
+} // namespace oksi
@@ -0,0 +1,65 @@
+// SHA-256 compression with ARMv8 Cryptography Extensions
+// ---------------------------------
+// Purpose:
+//   Hardware backend for sha256_detail::compress on AArch64 CPUs that report
+//   the SHA2 feature (e.g. Graviton, Apple silicon, Cortex-A53 and later with
+//   crypto). Compiled with a per-function target attribute so the rest of the
+//   binary keeps the baseline ISA; sha256_dispatch.cpp only selects it after
+//   checking HWCAP.
+//
+// Layout:
+//   State is kept as ABCD/EFGH vectors. Each loop iteration below performs
+//   4 rounds (SHA256H/SHA256H2) and extends the message schedule by 4 words
+//   (SHA256SU0/SHA256SU1).
+
+#include "sha256.hpp"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+#if defined(__clang__)
+#define OKSI_TARGET_ARMV8_SHA2 __attribute__((target("crypto")))
+#elif defined(__GNUC__)
+#define OKSI_TARGET_ARMV8_SHA2 __attribute__((target("+crypto")))
+#else
+#define OKSI_TARGET_ARMV8_SHA2
+#endif
+
+namespace oksi {
+namespace sha256_detail {
+
+OKSI_TARGET_ARMV8_SHA2
+void compress_armv8(uint32_t state[8], const uint8_t *data, size_t nblocks) {
+    uint32x4_t state0 = vld1q_u32(&state[0]);
+    uint32x4_t state1 = vld1q_u32(&state[4]);
+
+    for (; nblocks; --nblocks, data += 64) {
+        const uint32x4_t abcd_save = state0;
+        const uint32x4_t efgh_save = state1;
+
+        uint32x4_t w[4];
+        for (int i = 0; i < 4; ++i)
+            w[i] = vreinterpretq_u32_u8(vrev32q_u8(vld1q_u8(data + 16 * i)));
+
+        for (int i = 0; i < 16; ++i) {
+            const uint32x4_t wk = vaddq_u32(w[i & 3], vld1q_u32(&K[4 * i]));
+            const uint32x4_t abcd = state0;
+            state0 = vsha256hq_u32(state0, state1, wk);
+            state1 = vsha256h2q_u32(state1, abcd, wk);
+            if (i < 12)
+                w[i & 3] = vsha256su1q_u32(vsha256su0q_u32(w[i & 3], w[(i + 1) & 3]), w[(i + 2) & 3], w[(i + 3) & 3]);
+        }
+
+        state0 = vaddq_u32(state0, abcd_save);
+        state1 = vaddq_u32(state1, efgh_save);
+    }
+
+    vst1q_u32(&state[0], state0);
+    vst1q_u32(&state[4], state1);
+}
+
+} // namespace sha256_detail
+} // namespace oksi
+
+#endif
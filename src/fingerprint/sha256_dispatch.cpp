@@ -0,0 +1,224 @@
+// SHA-256 runtime backend selection
+// ---------------------------------
+// Purpose:
+//   Pick the SHA-256 compression function once per process based on what the
+//   CPU supports, keeping the portable implementation as the fallback:
+//     - x86/x86-64: SHA-NI (CPUID leaf 7 EBX.SHA, plus SSSE3/SSE4.1)
+//     - AArch64:    ARMv8 SHA2 (getauxval(AT_HWCAP) & HWCAP_SHA2 on Linux)
+//   and likewise the multi-lane engine used by sha256_many:
+//     - x86/x86-64: AVX-512F (16 lanes) or AVX2 (8 lanes), with OS support
+//                   for the register state checked through XGETBV
+//     - AArch64:    NEON (4 lanes)
+//
+// Override:
+//   OKSI_SHA256_IMPL=portable|shani|armv8 forces a backend (used by the tests
+//   to cover every path). OKSI_SHA256_MB_IMPL=scalar|neon|avx2|avx512 does the
+//   same for sha256_many. A forced backend the CPU (or build) cannot run is
+//   reported on stderr and the best available one is used instead, so a host
+//   process loading the library never dies over it. Executables that exist to
+//   exercise one backend check unavailable_backend_request() up front and exit
+//   with kBackendUnavailableExit, which CTest reports as skipped.
+
+#include "sha256.hpp"
+#include "sha256_multi.hpp"
+
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+#define OKSI_SHA256_X86 1
+#if defined(_MSC_VER)
+#include <intrin.h>
+#else
+#include <cpuid.h>
+#endif
+#elif defined(__aarch64__) || defined(_M_ARM64)
+#define OKSI_SHA256_ARM64 1
+#if defined(__linux__)
+#include <sys/auxv.h>
+#ifndef HWCAP_SHA2
+#define HWCAP_SHA2 (1 << 6)
+#endif
+#endif
+#endif
+
+namespace oksi {
+namespace sha256_detail {
+
+namespace {
+
+struct Backend {
+    const char *name;
+    CompressFn fn;
+};
+
+// True when the override variable is unset, empty or "auto"
+bool is_auto(const char *req) {
+    return !req || !*req || std::strcmp(req, "auto") == 0;
+}
+
+void report_fallback(const char *var, const char *req, const char *used) {
+    std::fprintf(stderr, "%s=%s: SHA-256 backend not available on this CPU, using %s\n", var, req, used);
+}
+
+#if defined(OKSI_SHA256_X86)
+struct X86Features {
+    bool shani = false;
+    bool avx2 = false;
+    bool avx512f = false;
+};
+
+void cpuid(unsigned int leaf, unsigned int sub, unsigned int r[4]) {
+#if defined(_MSC_VER)
+    int v[4];
+    __cpuidex(v, static_cast<int>(leaf), static_cast<int>(sub));
+    for (int i = 0; i < 4; ++i) r[i] = static_cast<unsigned int>(v[i]);
+#else
+    __cpuid_count(leaf, sub, r[0], r[1], r[2], r[3]);
+#endif
+}
+
+// XCR0: which register states the OS saves/restores on context switch.
+unsigned long long xgetbv0() {
+#if defined(_MSC_VER)
+    return _xgetbv(0);
+#else
+    unsigned int lo = 0, hi = 0;
+    __asm__ volatile("xgetbv" : "=a"(lo), "=d"(hi) : "c"(0));
+    return (static_cast<unsigned long long>(hi) << 32) | lo;
+#endif
+}
+
+X86Features detect_x86() {
+    X86Features f;
+    unsigned int r[4] = {};
+    cpuid(0, 0, r);
+    const unsigned int max_leaf = r[0];
+    if (max_leaf < 1) return f;
+    cpuid(1, 0, r);
+    const bool ssse3 = (r[2] >> 9) & 1;
+    const bool sse41 = (r[2] >> 19) & 1;
+    const bool osxsave = (r[2] >> 27) & 1;
+    const bool avx = (r[2] >> 28) & 1;
+    if (max_leaf < 7) return f;
+    cpuid(7, 0, r);
+    f.shani = ssse3 && sse41 && ((r[1] >> 29) & 1);
+    if (osxsave && avx) {
+        const unsigned long long xcr0 = xgetbv0();
+        const bool ymm_os = (xcr0 & 0x6) == 0x6;      // XMM + YMM
+        const bool zmm_os = (xcr0 & 0xe6) == 0xe6;    // + opmask, ZMM_Hi256, Hi16_ZMM
+        f.avx2 = ymm_os && ((r[1] >> 5) & 1);
+        f.avx512f = zmm_os && ((r[1] >> 16) & 1);
+    }
+    return f;
+}
+
+const X86Features &x86_features() {
+    static const X86Features f = detect_x86();
+    return f;
+}
+#endif
+
+#if defined(OKSI_SHA256_ARM64)
+bool cpu_has_armv8_sha2() {
+#if defined(__APPLE__)
+    return true; // all Apple arm64 cores implement the crypto extensions
+#elif defined(__linux__)
+    return (getauxval(AT_HWCAP) & HWCAP_SHA2) != 0;
+#else
+    return false;
+#endif
+}
+#endif
+
+Backend best_backend() {
+#if defined(OKSI_SHA256_X86)
+    if (x86_features().shani) return Backend{"shani", compress_shani};
+#elif defined(OKSI_SHA256_ARM64)
+    if (cpu_has_armv8_sha2()) return Backend{"armv8", compress_armv8};
+#endif
+    return Backend{"portable", compress_portable};
+}
+
+// Backend called name if this CPU can run it
+bool find_backend(const char *name, Backend &out) {
+    const Backend best = best_backend();
+    if (std::strcmp(name, best.name) == 0) out = best;
+    else if (std::strcmp(name, "portable") == 0) out = Backend{"portable", compress_portable};
+    else return false;
+    return true;
+}
+
+Backend select() {
+    const char *req = std::getenv("OKSI_SHA256_IMPL");
+    const Backend best = best_backend();
+    if (is_auto(req)) return best;
+    Backend forced{};
+    if (find_backend(req, forced)) return forced;
+    report_fallback("OKSI_SHA256_IMPL", req, best.name);
+    return best;
+}
+
+const Backend &selected() {
+    static const Backend backend = select();
+    return backend;
+}
+
+LaneEngine best_lanes() {
+#if defined(OKSI_SHA256_X86)
+    if (x86_features().avx512f) return LaneEngine{"avx512", 16, compress_x16_avx512};
+    if (x86_features().avx2) return LaneEngine{"avx2", 8, compress_x8_avx2};
+#elif defined(OKSI_SHA256_ARM64)
+    return LaneEngine{"neon", 4, compress_x4_neon};
+#endif
+    return LaneEngine{"scalar", 1, nullptr};
+}
+
+LaneEngine select_lanes() {
+    const char *req = std::getenv("OKSI_SHA256_MB_IMPL");
+    const LaneEngine best = best_lanes();
+    if (is_auto(req)) return best;
+    LaneEngine forced{};
+    if (find_lane_engine(req, forced)) return forced;
+    report_fallback("OKSI_SHA256_MB_IMPL", req, best.name);
+    return best;
+}
+
+} // namespace
+
+CompressFn compress() { return selected().fn; }
+
+const char *compress_name() { return selected().name; }
+
+const LaneEngine &lane_engine() {
+    static const LaneEngine engine = select_lanes();
+    return engine;
+}
+
+bool find_lane_engine(const char *name, LaneEngine &out) {
+    const LaneEngine best = best_lanes();
+    if (std::strcmp(name, best.name) == 0) out = best;
+    else if (std::strcmp(name, "scalar") == 0) out = LaneEngine{"scalar", 1, nullptr};
+#if defined(OKSI_SHA256_X86)
+    // AVX2 is still available when the widest engine is AVX-512
+    else if (std::strcmp(name, "avx2") == 0 && x86_features().avx2) out = LaneEngine{"avx2", 8, compress_x8_avx2};
+#endif
+    else return false;
+    return true;
+}
+
+const char *unavailable_backend_request() {
+    static std::string request; // "VAR=value" of the first unmet override
+    Backend backend{};
+    LaneEngine engine{};
+    const char *req = std::getenv("OKSI_SHA256_IMPL");
+    if (!is_auto(req) && !find_backend(req, backend)) return (request = std::string("OKSI_SHA256_IMPL=") + req).c_str();
+    req = std::getenv("OKSI_SHA256_MB_IMPL");
+    if (!is_auto(req) && !find_lane_engine(req, engine)) return (request = std::string("OKSI_SHA256_MB_IMPL=") + req).c_str();
+    return nullptr;
+}
+
+} // namespace sha256_detail
+} // namespace oksi
@@ -0,0 +1,43 @@
+// Multi-lane SHA-256: AVX2 backend (8 lanes)
+// ---------------------------------
+// Compiled with -mavx2 (see CMakeLists.txt); only selected after CPUID and
+// XGETBV confirm AVX2 support. Uses nothing from sha256.hpp except K, so no
+// AVX2-compiled inline code can leak into baseline callers.
+
+#include "sha256_mb_kernel.hpp"
+#include "sha256_multi.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+#include <immintrin.h>
+
+namespace oksi {
+namespace sha256_detail {
+
+namespace {
+
+struct Avx2Ops {
+    using vec = __m256i;
+    static constexpr size_t lanes = 8;
+
+    static vec load(const uint32_t *p) { return _mm256_load_si256(reinterpret_cast<const __m256i*>(p)); }
+    static void store(uint32_t *p, vec v) { _mm256_store_si256(reinterpret_cast<__m256i*>(p), v); }
+    static vec set1(uint32_t x) { return _mm256_set1_epi32(static_cast<int>(x)); }
+    static vec add(vec a, vec b) { return _mm256_add_epi32(a, b); }
+    static vec xor3(vec a, vec b, vec c) { return _mm256_xor_si256(_mm256_xor_si256(a, b), c); }
+    static vec ch(vec x, vec y, vec z) { return _mm256_xor_si256(_mm256_and_si256(x, y), _mm256_andnot_si256(x, z)); }
+    static vec maj(vec x, vec y, vec z) { return _mm256_or_si256(_mm256_and_si256(x, y), _mm256_and_si256(z, _mm256_or_si256(x, y))); }
+    template <int n> static vec rotr(vec x) { return _mm256_or_si256(_mm256_srli_epi32(x, n), _mm256_slli_epi32(x, 32 - n)); }
+    template <int n> static vec shr(vec x) { return _mm256_srli_epi32(x, n); }
+};
+
+} // namespace
+
+void compress_x8_avx2(uint32_t *state, const uint32_t *block) {
+    compress_lanes<Avx2Ops>(state, block);
+}
+
+} // namespace sha256_detail
+} // namespace oksi
+
+#endif
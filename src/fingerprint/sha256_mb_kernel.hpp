@@ -0,0 +1,70 @@
+// Multi-lane SHA-256 compression kernel (C++)
+// ---------------------------------
+// Purpose:
+//   One generic 64-round compression over N independent SHA-256 states held
+//   in SIMD lanes ("multi-buffer" hashing). Each ISA backend (AVX2, AVX-512,
+//   NEON) supplies a small ops struct and instantiates compress_lanes<Ops>.
+//
+// Layout:
+//   state[i * Ops::lanes + l] is working word i (a..h) of lane l, and
+//   block[t * Ops::lanes + l] is big-endian message word t of lane l, i.e.
+//   both are transposed so one vector load fetches a word for every lane.
+//
+// Ops interface:
+//   vec, lanes, load, store, set1, add, xor3, ch, maj, rotr<n>, shr<n>
+//
+// Only include this from the backend translation units, which are compiled
+// with the matching ISA flags.
+
+#pragma once
+
+#include "sha256.hpp"
+
+namespace oksi {
+namespace sha256_detail {
+
+template <class Ops>
+inline void compress_lanes(uint32_t *state, const uint32_t *block) {
+    using vec = typename Ops::vec;
+    constexpr size_t L = Ops::lanes;
+
+    vec w[16];
+    for (int t = 0; t < 16; ++t) w[t] = Ops::load(block + t * L);
+
+    vec a = Ops::load(state + 0 * L);
+    vec b = Ops::load(state + 1 * L);
+    vec c = Ops::load(state + 2 * L);
+    vec d = Ops::load(state + 3 * L);
+    vec e = Ops::load(state + 4 * L);
+    vec f = Ops::load(state + 5 * L);
+    vec g = Ops::load(state + 6 * L);
+    vec h = Ops::load(state + 7 * L);
+
+    for (int t = 0; t < 64; ++t) {
+        if (t >= 16) {
+            // Message schedule kept in a 16-word ring
+            const vec w2 = w[(t - 2) & 15];
+            const vec w15 = w[(t - 15) & 15];
+            const vec s1 = Ops::xor3(Ops::template rotr<17>(w2), Ops::template rotr<19>(w2), Ops::template shr<10>(w2));
+            const vec s0 = Ops::xor3(Ops::template rotr<7>(w15), Ops::template rotr<18>(w15), Ops::template shr<3>(w15));
+            w[t & 15] = Ops::add(Ops::add(s1, w[(t - 7) & 15]), Ops::add(s0, w[t & 15]));
+        }
+        const vec e1 = Ops::xor3(Ops::template rotr<6>(e), Ops::template rotr<11>(e), Ops::template rotr<25>(e));
+        const vec e0 = Ops::xor3(Ops::template rotr<2>(a), Ops::template rotr<13>(a), Ops::template rotr<22>(a));
+        const vec t1 = Ops::add(Ops::add(Ops::add(h, e1), Ops::add(Ops::ch(e, f, g), Ops::set1(K[t]))), w[t & 15]);
+        const vec t2 = Ops::add(e0, Ops::maj(a, b, c));
+        h = g; g = f; f = e; e = Ops::add(d, t1); d = c; c = b; b = a; a = Ops::add(t1, t2);
+    }
+
+    Ops::store(state + 0 * L, Ops::add(a, Ops::load(state + 0 * L)));
+    Ops::store(state + 1 * L, Ops::add(b, Ops::load(state + 1 * L)));
+    Ops::store(state + 2 * L, Ops::add(c, Ops::load(state + 2 * L)));
+    Ops::store(state + 3 * L, Ops::add(d, Ops::load(state + 3 * L)));
+    Ops::store(state + 4 * L, Ops::add(e, Ops::load(state + 4 * L)));
+    Ops::store(state + 5 * L, Ops::add(f, Ops::load(state + 5 * L)));
+    Ops::store(state + 6 * L, Ops::add(g, Ops::load(state + 6 * L)));
+    Ops::store(state + 7 * L, Ops::add(h, Ops::load(state + 7 * L)));
+}
+
+} // namespace sha256_detail
+} // namespace oksi
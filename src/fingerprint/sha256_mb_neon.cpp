@@ -0,0 +1,42 @@
+// Multi-lane SHA-256: NEON backend (4 lanes)
+// ---------------------------------
+// Advanced SIMD is part of the AArch64 baseline, so no extra flags or
+// runtime checks are needed beyond the architecture guard.
+
+#include "sha256_mb_kernel.hpp"
+#include "sha256_multi.hpp"
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+namespace oksi {
+namespace sha256_detail {
+
+namespace {
+
+struct NeonOps {
+    using vec = uint32x4_t;
+    static constexpr size_t lanes = 4;
+
+    static vec load(const uint32_t *p) { return vld1q_u32(p); }
+    static void store(uint32_t *p, vec v) { vst1q_u32(p, v); }
+    static vec set1(uint32_t x) { return vdupq_n_u32(x); }
+    static vec add(vec a, vec b) { return vaddq_u32(a, b); }
+    static vec xor3(vec a, vec b, vec c) { return veorq_u32(veorq_u32(a, b), c); }
+    static vec ch(vec x, vec y, vec z) { return vbslq_u32(x, y, z); }
+    static vec maj(vec x, vec y, vec z) { return vbslq_u32(veorq_u32(x, y), z, y); }
+    template <int n> static vec rotr(vec x) { return vsriq_n_u32(vshlq_n_u32(x, 32 - n), x, n); }
+    template <int n> static vec shr(vec x) { return vshrq_n_u32(x, n); }
+};
+
+} // namespace
+
+void compress_x4_neon(uint32_t *state, const uint32_t *block) {
+    compress_lanes<NeonOps>(state, block);
+}
+
+} // namespace sha256_detail
+} // namespace oksi
+
+#endif
@@ -0,0 +1,120 @@
+// Multi-lane SHA-256 driver (C++)
+// ---------------------------------
+// Purpose:
+//   Lane scheduling for sha256_many: builds each lane's next padded block,
+//   transposes it into the SIMD layout, calls the selected lane kernel and
+//   harvests finished digests. Compiled for the baseline ISA; only the lane
+//   kernels use wider instructions.
+
+#include "sha256_multi.hpp"
+
+#include "sha256.hpp"
+
+#include <cstring>
+
+namespace oksi {
+namespace sha256_detail {
+
+namespace {
+
+constexpr size_t kMaxLanes = 16;
+
+const uint32_t kIV[8] = {
+    0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a,
+    0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19
+};
+
+// Number of 64-byte blocks after padding (0x80, zeros, 64-bit bit length).
+size_t padded_blocks(size_t len) { return (len + 8) / 64 + 1; }
+
+// Write block idx of the padded message into out[0..63].
+void padded_block(const std::string &msg, size_t idx, size_t nblocks, uint8_t *out) {
+    const size_t len = msg.size();
+    const size_t off = idx * 64;
+    size_t n = 0;
+    if (off < len) {
+        n = len - off < 64 ? len - off : 64;
+        std::memcpy(out, msg.data() + off, n);
+    }
+    std::memset(out + n, 0, 64 - n);
+    if (off + n == len && n < 64) out[n] = 0x80;
+    if (idx + 1 == nblocks) {
+        const uint64_t bits = static_cast<uint64_t>(len) * 8;
+        for (int i = 0; i < 8; ++i) out[63 - i] = static_cast<uint8_t>(bits >> (8 * i));
+    }
+}
+
+struct Lane {
+    size_t msg;
+    size_t block;
+    size_t nblocks;
+    bool busy;
+};
+
+} // namespace
+
+void sha256_many_with(const LaneEngine &engine, const std::string *msgs, size_t n, std::array<uint8_t,32> *digests) {
+    if (engine.lanes <= 1 || !engine.fn) {
+        for (size_t i = 0; i < n; ++i) {
+            SHA256 sha;
+            sha.update(msgs[i]);
+            digests[i] = sha.digest();
+        }
+        return;
+    }
+
+    const size_t L = engine.lanes;
+    alignas(64) uint32_t state[8 * kMaxLanes] = {};
+    alignas(64) uint32_t block[16 * kMaxLanes] = {};
+    Lane lanes[kMaxLanes] = {};
+    uint8_t buf[64];
+    size_t next = 0;
+
+    for (;;) {
+        size_t busy = 0;
+        for (size_t l = 0; l < L; ++l) {
+            Lane &ln = lanes[l];
+            if (!ln.busy && next < n) {
+                ln = Lane{next, 0, padded_blocks(msgs[next].size()), true};
+                ++next;
+                for (int i = 0; i < 8; ++i) state[i * L + l] = kIV[i];
+            }
+            if (!ln.busy) continue;  // idle lane: stale words, result ignored
+            ++busy;
+            padded_block(msgs[ln.msg], ln.block, ln.nblocks, buf);
+            for (int t = 0; t < 16; ++t) {
+                const uint8_t *p = buf + 4 * t;
+                block[t * L + l] = (uint32_t(p[0]) << 24) | (uint32_t(p[1]) << 16) | (uint32_t(p[2]) << 8) | uint32_t(p[3]);
+            }
+        }
+        if (!busy) break;
+
+        engine.fn(state, block);
+
+        for (size_t l = 0; l < L; ++l) {
+            Lane &ln = lanes[l];
+            if (!ln.busy || ++ln.block < ln.nblocks) continue;
+            std::array<uint8_t,32> &out = digests[ln.msg];
+            for (int i = 0; i < 8; ++i) {
+                const uint32_t v = state[i * L + l];
+                out[4 * i]     = static_cast<uint8_t>(v >> 24);
+                out[4 * i + 1] = static_cast<uint8_t>(v >> 16);
+                out[4 * i + 2] = static_cast<uint8_t>(v >> 8);
+                out[4 * i + 3] = static_cast<uint8_t>(v);
+            }
+            ln.busy = false;
+        }
+    }
+}
+
+} // namespace sha256_detail
+
+void sha256_many(const std::string *msgs, size_t n, std::array<uint8_t,32> *digests) {
+    sha256_detail::sha256_many_with(sha256_detail::lane_engine(), msgs, n, digests);
+}
+
+size_t sha256_many_lanes() { return sha256_detail::lane_engine().lanes; }
+
+const char *sha256_many_name() { return sha256_detail::lane_engine().name; }
+
+} // namespace oksi
@@ -0,0 +1,67 @@
+// Multi-lane SHA-256 (C++)
+// ---------------------------------
+// Purpose:
+//   Hash many short, independent messages at once by running 4, 8 or 16
+//   SHA-256 computations side by side in SIMD lanes (NEON, AVX2, AVX-512).
+//   Intended for batch fingerprinting, where most of the work is hashing
+//   "mid:...|salt:..." strings of one or two blocks each.
+//
+// How it works:
+//   Each lane owns one message at a time. Every step compresses one block in
+//   every busy lane; each lane pads its own message, so uneven lengths are
+//   fine. When a lane finishes, its digest is written out and the lane picks
+//   up the next message. Idle lanes at the tail are masked out of the result.
+//
+// Selection:
+//   The widest engine the CPU supports is picked once per process; override
+//   with OKSI_SHA256_MB_IMPL=scalar|neon|avx2|avx512 (scalar is a loop over the
+//   single-stream SHA256). A request the CPU cannot run is reported on stderr
+//   and the library keeps the widest supported engine; oksi_fingerprint and
+//   the tests exit with kBackendUnavailableExit (77) instead.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace oksi {
+
+// digests[i] = SHA-256(msgs[i]) for i in [0, n).
+void sha256_many(const std::string *msgs, size_t n, std::array<uint8_t,32> *digests);
+
+// Lane count and name of the engine sha256_many uses, e.g. 16 / "avx512".
+size_t sha256_many_lanes();
+const char *sha256_many_name();
+
+namespace sha256_detail {
+
+// Compress one block in every lane; layouts as in sha256_mb_kernel.hpp.
+// state and block must be aligned to 64 bytes.
+using LaneCompressFn = void (*)(uint32_t *state, const uint32_t *block);
+
+struct LaneEngine {
+    const char *name;
+    size_t lanes;        // 1 = scalar fallback, fn unused
+    LaneCompressFn fn;
+};
+
+// Engine selected once per process (see sha256_dispatch.cpp).
+const LaneEngine &lane_engine();
+
+// Engine called name ("scalar", "neon", "avx2", "avx512") if this CPU can run
+// it; false otherwise (benchmarks and tests).
+bool find_lane_engine(const char *name, LaneEngine &out);
+
+// Run sha256_many on a specific engine (benchmarks and tests).
+void sha256_many_with(const LaneEngine &engine, const std::string *msgs, size_t n, std::array<uint8_t,32> *digests);
+
+// Backends; only call these after the dispatcher confirmed CPU support.
+void compress_x4_neon(uint32_t *state, const uint32_t *block);
+void compress_x8_avx2(uint32_t *state, const uint32_t *block);
+void compress_x16_avx512(uint32_t *state, const uint32_t *block);
+
+} // namespace sha256_detail
+
+} // namespace oksi
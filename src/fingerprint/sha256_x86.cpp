@@ -0,0 +1,80 @@
+// SHA-256 compression with Intel SHA extensions (SHA-NI)
+// ---------------------------------
+// Purpose:
+//   Hardware backend for sha256_detail::compress on x86/x86-64 CPUs that
+//   report the SHA feature (Goldmont, Ice Lake and later, AMD Zen). The
+//   function is compiled with a per-function target attribute so the rest of
+//   the binary keeps the baseline ISA; sha256_dispatch.cpp only selects it
+//   after checking CPUID.
+//
+// Layout:
+//   The SHA-NI round instructions operate on the state split as ABEF/CDGH,
+//   so the state is shuffled in on entry and back out on exit. Each loop
+//   iteration below performs 4 rounds and extends the message schedule by
+//   4 words with SHA256MSG1/SHA256MSG2.
+
+#include "sha256.hpp"
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+
+#include <immintrin.h>
+
+#if defined(__GNUC__) || defined(__clang__)
+#define OKSI_TARGET_SHANI __attribute__((target("sha,sse4.1")))
+#else
+#define OKSI_TARGET_SHANI
+#endif
+
+namespace oksi {
+namespace sha256_detail {
+
+OKSI_TARGET_SHANI
+void compress_shani(uint32_t state[8], const uint8_t *data, size_t nblocks) {
+    const __m128i byteswap = _mm_set_epi64x(0x0c0d0e0f08090a0bULL, 0x0405060700010203ULL);
+
+    // Load state and reorder ABCD/EFGH into ABEF/CDGH
+    __m128i tmp = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[0]));
+    __m128i state1 = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&state[4]));
+    tmp = _mm_shuffle_epi32(tmp, 0xB1);          // CDAB
+    state1 = _mm_shuffle_epi32(state1, 0x1B);    // EFGH
+    __m128i state0 = _mm_alignr_epi8(tmp, state1, 8);  // ABEF
+    state1 = _mm_blend_epi16(state1, tmp, 0xF0);       // CDGH
+
+    for (; nblocks; --nblocks, data += 64) {
+        const __m128i abef_save = state0;
+        const __m128i cdgh_save = state1;
+
+        __m128i w[4];
+        for (int i = 0; i < 4; ++i)
+            w[i] = _mm_shuffle_epi8(_mm_loadu_si128(reinterpret_cast<const __m128i*>(data + 16 * i)), byteswap);
+
+        for (int i = 0; i < 16; ++i) {
+            __m128i msg = _mm_add_epi32(w[i & 3], _mm_loadu_si128(reinterpret_cast<const __m128i*>(&K[4 * i])));
+            state1 = _mm_sha256rnds2_epu32(state1, state0, msg);
+            msg = _mm_shuffle_epi32(msg, 0x0E);
+            state0 = _mm_sha256rnds2_epu32(state0, state1, msg);
+            if (i < 12) {
+                // Extend the schedule: replaces w[i] with message words 4(i+4)..4(i+4)+3
+                __m128i next = _mm_sha256msg1_epu32(w[i & 3], w[(i + 1) & 3]);
+                next = _mm_add_epi32(next, _mm_alignr_epi8(w[(i + 3) & 3], w[(i + 2) & 3], 4));
+                w[i & 3] = _mm_sha256msg2_epu32(next, w[(i + 3) & 3]);
+            }
+        }
+
+        state0 = _mm_add_epi32(state0, abef_save);
+        state1 = _mm_add_epi32(state1, cdgh_save);
+    }
+
+    // Reorder ABEF/CDGH back into ABCD/EFGH and store
+    tmp = _mm_shuffle_epi32(state0, 0x1B);       // FEBA
+    state1 = _mm_shuffle_epi32(state1, 0xB1);    // DCHG
+    state0 = _mm_blend_epi16(tmp, state1, 0xF0); // DCBA
+    state1 = _mm_alignr_epi8(state1, tmp, 8);    // HGFE
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[0]), state0);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(&state[4]), state1);
+}
+
+} // namespace sha256_detail
+} // namespace oksi
+
+#endif
@@ -0,0 +1,68 @@
+/* C ABI smoke test for liboksi_fingerprint.
+ * Usage: oksi_fingerprint_capi_test <mid_abcd.txt> <mid_test_machine_id.txt>
+ * Expected values match the add_fp_test CLI vectors in CMakeLists.txt.
+ */
+
+#include "oksi_fingerprint.h"
+
+#include <stdio.h>
+#include <string.h>
+
+static int failures = 0;
+
+static void expect_fp(const char *name, int rc, const char *got, const char *want) {
+    if (rc != OKSI_FP_OK || strcmp(got, want) != 0) {
+        fprintf(stderr, "FAIL %s: rc=%d got='%s' want='%s'\n", name, rc, got, want);
+        failures++;
+    }
+}
+
+static void expect_rc(const char *name, int rc, int want) {
+    if (rc != want) {
+        fprintf(stderr, "FAIL %s: rc=%d want=%d\n", name, rc, want);
+        failures++;
+    }
+}
+
+int main(int argc, char **argv) {
+    char out[OKSI_FINGERPRINT_LEN + 1];
+    int rc;
+
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <mid_abcd> <mid_tmid>\n", argv[0]);
+        return 2;
+    }
+
+    rc = oksi_fingerprint(NULL, argv[1], out, sizeof out);
+    expect_fp("abcd_no_salt", rc, out, "yTsFgAbUO-EC-QOPPPGqz0WhmfqWMbIZARKwKWF9ldw");
+    rc = oksi_fingerprint("prod-42", argv[1], out, sizeof out);
+    expect_fp("abcd_salt_prod42", rc, out, "65wHlLMSzCOIJAX310spHpZj0hVpklt-UQY3fq6cBGA");
+    rc = oksi_fingerprint("s", argv[2], out, sizeof out);
+    expect_fp("tmid_salt_s", rc, out, "yhj7m4amszguzHbxU9--PWsfRhmytmNEqB4u0Z4Vmk0");
+
+    rc = oksi_fingerprint_from_machine_id("test-machine-id\n", "", out, sizeof out);
+    expect_fp("tmid_value_no_salt", rc, out, "sVZ6CUxvt-celxdj2bqMUFvzqNGQE9xZ8SGTNh_LU6o");
+    rc = oksi_fingerprint_from_machine_id("abcd", "s", out, sizeof out);
+    expect_fp("abcd_value_salt_s", rc, out, "OYGS4aIPb4PWsdsbF4c9GhkCp_6mFrugH7-4ufNR_-4");
+
+    {
+        const char *salts[] = {"s", NULL, "prod-42"};
+        char many[3][OKSI_FINGERPRINT_LEN + 1];
+        rc = oksi_fingerprint_salts(argv[1], salts, 3, &many[0][0], sizeof many[0]);
+        expect_fp("salts_0", rc, many[0], "OYGS4aIPb4PWsdsbF4c9GhkCp_6mFrugH7-4ufNR_-4");
+        expect_fp("salts_1", rc, many[1], "yTsFgAbUO-EC-QOPPPGqz0WhmfqWMbIZARKwKWF9ldw");
+        expect_fp("salts_2", rc, many[2], "65wHlLMSzCOIJAX310spHpZj0hVpklt-UQY3fq6cBGA");
+        expect_rc("salts_null", oksi_fingerprint_salts(argv[1], NULL, 1, &many[0][0], sizeof many[0]), OKSI_FP_EINVAL);
+        expect_rc("salts_stride", oksi_fingerprint_salts(argv[1], salts, 3, &many[0][0], OKSI_FINGERPRINT_LEN), OKSI_FP_ERANGE);
+    }
+
+    expect_rc("null_out", oksi_fingerprint(NULL, argv[1], NULL, 64), OKSI_FP_EINVAL);
+    expect_rc("short_cap", oksi_fingerprint(NULL, argv[1], out, OKSI_FINGERPRINT_LEN), OKSI_FP_ERANGE);
+
+    if (strlen(oksi_fingerprint_version()) == 0) {
+        fprintf(stderr, "FAIL version: empty\n");
+        failures++;
+    }
+
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,111 @@
+// Known-answer tests for the oksi_verify primitives.
+// Usage: oksi_verify_crypto_test
+// Vectors: FIPS 180-2 (SHA-512), RFC 8032 section 7.1 (Ed25519) and the GCM
+// specification test cases 13-15 (AES-256-GCM).
+
+#include "crypto.hpp"
+#include "json_lite.hpp"
+#include "machine_file.hpp"
+
+#include <cstdio>
+#include <string>
+#include <vector>
+
+static int failures = 0;
+
+static std::vector<uint8_t> unhex(const std::string &h) {
+    std::vector<uint8_t> out;
+    for (size_t i = 0; i + 1 < h.size(); i += 2) out.push_back(uint8_t(std::stoul(h.substr(i, 2), nullptr, 16)));
+    return out;
+}
+
+static std::string hex(const uint8_t *p, size_t n) {
+    static const char digits[] = "0123456789abcdef";
+    std::string s;
+    for (size_t i = 0; i < n; ++i) {
+        s += digits[p[i] >> 4];
+        s += digits[p[i] & 15];
+    }
+    return s;
+}
+
+static void expect(const char *name, bool ok) {
+    if (!ok) {
+        std::fprintf(stderr, "FAIL %s\n", name);
+        failures++;
+    }
+}
+
+static void expect_eq(const char *name, const std::string &got, const std::string &want) {
+    if (got != want) {
+        std::fprintf(stderr, "FAIL %s: got %s want %s\n", name, got.c_str(), want.c_str());
+        failures++;
+    }
+}
+
+static void sha512_case(const char *name, const std::string &msg, const char *want) {
+    const auto d = oksi::sha512(reinterpret_cast<const uint8_t *>(msg.data()), msg.size());
+    expect_eq(name, hex(d.data(), d.size()), want);
+}
+
+static void ed25519_case(const char *name, const char *pk_hex, const char *msg_hex, const char *sig_hex) {
+    const auto pk = unhex(pk_hex), msg = unhex(msg_hex);
+    auto sig = unhex(sig_hex);
+    expect(name, oksi::ed25519_verify(sig.data(), msg.data(), msg.size(), pk.data()));
+    sig[10] ^= 1;
+    expect((std::string(name) + "_tampered_r").c_str(), !oksi::ed25519_verify(sig.data(), msg.data(), msg.size(), pk.data()));
+    sig[10] ^= 1;
+    sig[40] ^= 1;
+    expect((std::string(name) + "_tampered_s").c_str(), !oksi::ed25519_verify(sig.data(), msg.data(), msg.size(), pk.data()));
+}
+
+static void gcm_case(const char *name, const char *key, const char *iv, const char *pt, const char *ct, const char *tag) {
+    const auto k = unhex(key), n = unhex(iv), c = unhex(ct);
+    auto t = unhex(tag);
+    std::vector<uint8_t> out;
+    expect(name, oksi::aes256_gcm_decrypt(k.data(), n.data(), c.data(), c.size(), t.data(), out) &&
+                     hex(out.data(), out.size()) == pt);
+    t[0] ^= 0x80;
+    expect((std::string(name) + "_bad_tag").c_str(),
+           !oksi::aes256_gcm_decrypt(k.data(), n.data(), c.data(), c.size(), t.data(), out) && out.empty());
+}
+
+int main() {
+    sha512_case("sha512_empty", "",
+                "cf83e1357eefb8bdf1542850d66d8007d620e4050b5715dc83f4a921d36ce9ce"
+                "47d0d13c5d85f2b0ff8318d2877eec2f63b931bd47417a81a538327af927da3e");
+    sha512_case("sha512_abc", "abc",
+                "ddaf35a193617abacc417349ae20413112e6fa4e89a97ea20a9eeee64b55d39a"
+                "2192992a274fc1a836ba3c23a3feebbd454d4423643ce80e2a9ac94fa54ca49f");
+    sha512_case("sha512_two_blocks",
+                "abcdefghbcdefghicdefghijdefghijkefghijklfghijklmghijklmnhijklmno"
+                "ijklmnopjklmnopqklmnopqrlmnopqrsmnopqrstnopqrstu",
+                "8e959b75dae313da8cf4f72814fc143f8f7779c6eb9f7fa17299aeadb6889018"
+                "501d289e4900f7e4331b99dec4b5433ac7d329eeb6dd26545e96e55b874be909");
+
+    ed25519_case("ed25519_rfc8032_1",
+                 "d75a980182b10ab7d54bfed3c964073a0ee172f3daa62325af021a68f707511a", "",
+                 "e5564300c360ac729086e2cc806e828a84877f1eb8e5d974d873e065224901555fb8821590a33bacc61e39701cf9b46bd25bf5f0595bbe24655141438e7a100b");
+    ed25519_case("ed25519_rfc8032_2",
+                 "3d4017c3e843895a92b70aa74d1b7ebc9c982ccf2ec4968cc0cd55f12af4660c", "72",
+                 "92a009a9f0d4cab8720e820b5f642540a2b27b5416503f8fb3762223ebdb69da085ac1e43e15996e458f3613d0f11d8c387b2eaeb4302aeeb00d291612bb0c00");
+
+    const std::string zeros32(64, '0');
+    gcm_case("gcm_13", zeros32.c_str(), "000000000000000000000000", "", "", "530f8afbc74536b9a963b4f1c4cb738b");
+    gcm_case("gcm_14", zeros32.c_str(), "000000000000000000000000", "00000000000000000000000000000000",
+             "cea7403d4d606b6e074ec5d3baf39d18", "d0d1c8a799996bf0265b98b5d48ab919");
+    gcm_case("gcm_15", "feffe9928665731c6d6a8f9467308308feffe9928665731c6d6a8f9467308308", "cafebabefacedbaddecaf888",
+             "d9313225f88406e5a55909c5aff5269a86a7a9531534f7da2e4c303d8a318a721c3c0c95956809532fcf0e2449a6b525b16aedf5aa0de657ba637b391aafd255",
+             "522dc1f099567d07f47f37a32a84427d643a8cdcbfe5c0c97598a2bd2555d1aa8cb08e48590dbb3da7b08b1056828838c5f61e6393ba7a0abcc9f662898015ad",
+             "b094dac5d93471bdec1a502270e3cc6c");
+
+    // Base64 fallbacks and Python-compatible JSON rendering
+    expect_eq("b64_urlsafe_nopad", hex(oksi::b64_any_decode("-_8").data(), 2), "fbff");
+    expect_eq("json_dump", oksi::json_dump(oksi::json_parse(
+                  "{\"a\":[1,2.50,1e20,-0,{}],\"b\":\"\\u00e9\\ud83d\\ude00\",\"a\":null,\"c\":[]}")),
+              "{\n  \"a\": null,\n  \"b\": \"\\u00e9\\ud83d\\ude00\",\n  \"c\": []\n}");
+    expect_eq("json_numbers", oksi::json_dump(oksi::json_parse("[1,2.50,1e20,-0,1E-7,0.0001,123456789012345678]"), 0),
+              "[\n1,\n2.5,\n1e+20,\n0,\n1e-07,\n0.0001,\n123456789012345678\n]");
+
+    return failures ? 1 : 0;
+}
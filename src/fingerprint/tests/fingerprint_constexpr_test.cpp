@@ -0,0 +1,72 @@
+// Compile-time fingerprint tests: the static_asserts mirror the add_fp_test
+// CTest vectors, so this file failing to compile is the failure mode. The
+// runtime checks confirm the dispatched SHA-256 path agrees with the
+// constant-evaluated one.
+// Usage: oksi_fingerprint_constexpr_test
+
+#include "fingerprint_constexpr.hpp"
+#include "fingerprint_core.hpp"
+
+#include <cstdio>
+#include <string>
+
+namespace {
+
+constexpr bool digest_is(std::string_view msg, const uint8_t (&want)[32]) {
+    oksi::SHA256 sha;
+    sha.update(msg);
+    const auto got = sha.digest();
+    for (size_t i = 0; i < 32; ++i)
+        if (got[i] != want[i]) return false;
+    return true;
+}
+
+// FIPS 180-2 "abc" and the two-block message
+constexpr uint8_t kAbc[32] = {0xba, 0x78, 0x16, 0xbf, 0x8f, 0x01, 0xcf, 0xea, 0x41, 0x41, 0x40, 0xde, 0x5d, 0xae, 0x22, 0x23,
+                              0xb0, 0x03, 0x61, 0xa3, 0x96, 0x17, 0x7a, 0x9c, 0xb4, 0x10, 0xff, 0x61, 0xf2, 0x00, 0x15, 0xad};
+constexpr uint8_t kTwoBlock[32] = {0x24, 0x8d, 0x6a, 0x61, 0xd2, 0x06, 0x38, 0xb8, 0xe5, 0xc0, 0x26, 0x93, 0x0c, 0x3e, 0x60, 0x39,
+                                   0xa3, 0x3c, 0xe4, 0x59, 0x64, 0xff, 0x21, 0x67, 0xf6, 0xec, 0xed, 0xd4, 0x19, 0xdb, 0x06, 0xc1};
+static_assert(digest_is("abc", kAbc), "SHA-256(abc)");
+static_assert(digest_is("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq", kTwoBlock), "SHA-256 two blocks");
+
+constexpr std::string_view kLongSalt =
+    "prod-01234567890123456789012345678901234567890123456789012345678901234567890123456789"
+    "01234567890123456789012345678901234567890123456789012345678901234567890123456789"
+    "0123456789012345678901234567890123456789";
+
+// mid: abcd
+static_assert(oksi::fingerprint_of("abcd", "").view() == "yTsFgAbUO-EC-QOPPPGqz0WhmfqWMbIZARKwKWF9ldw", "fp_abcd_no_salt");
+static_assert(oksi::fingerprint_of("abcd", "s").view() == "OYGS4aIPb4PWsdsbF4c9GhkCp_6mFrugH7-4ufNR_-4", "fp_abcd_salt_s");
+static_assert(oksi::fingerprint_of("abcd", "prod-42").view() == "65wHlLMSzCOIJAX310spHpZj0hVpklt-UQY3fq6cBGA", "fp_abcd_salt_prod42");
+static_assert(oksi::fingerprint_of("abcd", kLongSalt).view() == "Ue-lIdrg1z4MrCei_Ei9Q9oI5G4ng--AP5EK3d6Ss7Q", "fp_abcd_salt_long");
+
+// mid: test-machine-id
+static_assert(oksi::fingerprint_of("test-machine-id", "").view() == "sVZ6CUxvt-celxdj2bqMUFvzqNGQE9xZ8SGTNh_LU6o", "fp_tmid_no_salt");
+static_assert(oksi::fingerprint_of("test-machine-id", "s").view() == "yhj7m4amszguzHbxU9--PWsfRhmytmNEqB4u0Z4Vmk0", "fp_tmid_salt_s");
+static_assert(oksi::fingerprint_of("test-machine-id", "prod-42").view() == "CLm2TxO-CbHvAaMX4uS6G4PqN28KVF4e-_wskFWLwHs", "fp_tmid_salt_prod42");
+
+#if defined(__cpp_nontype_template_args) && __cpp_nontype_template_args >= 201911L
+static_assert(oksi::fingerprint_v<"abcd"> == oksi::fingerprint_of("abcd", ""), "fingerprint_v no salt");
+static_assert(oksi::fingerprint_v<"abcd", "prod-42">.view() == "65wHlLMSzCOIJAX310spHpZj0hVpklt-UQY3fq6cBGA", "fingerprint_v");
+static_assert(oksi::fingerprint_v<"test-machine-id", "s">.view() == "yhj7m4amszguzHbxU9--PWsfRhmytmNEqB4u0Z4Vmk0", "fingerprint_v tmid");
+#endif
+
+int failures = 0;
+
+void expect_runtime(const std::string &mid, const std::string &salt) {
+    // Not constant-evaluated: goes through the dispatched backend
+    const oksi::StaticFingerprint fp = oksi::fingerprint_of(mid, salt);
+    if (std::string(fp.c_str()) != oksi::compute_fingerprint(mid, salt)) {
+        std::fprintf(stderr, "FAIL runtime mid='%s' salt='%s'\n", mid.c_str(), salt.c_str());
+        failures++;
+    }
+}
+
+} // namespace
+
+int main() {
+    for (const char *mid : {"", "abcd", "test-machine-id"})
+        for (const std::string &salt : {std::string(), std::string("s"), std::string("prod-42"), std::string(kLongSalt)})
+            expect_runtime(mid, salt);
+    return failures ? 1 : 0;
+}
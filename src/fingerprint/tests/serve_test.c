@@ -0,0 +1,259 @@
+/* Daemon-mode test for oksi_fingerprint --serve (Linux).
+ * Usage: oksi_fingerprint_serve_test <oksi_fingerprint> <mid_abcd.txt>
+ * Starts the server on a private socket (replacing a stale socket left at
+ * that path), sends pipelined requests on one connection plus one on a second
+ * connection and checks the answers against the add_fp_test vectors. Then:
+ *   - a client that pipelines without reading is throttled (its writes block)
+ *     and still gets every reply once it reads;
+ *   - the daemon stays idle while a half-closed client leaves replies unread;
+ *   - --serve refuses a path that is a live socket or a regular file.
+ * Finally stops the server with SIGTERM and checks that the socket file was
+ * removed.
+ */
+
+#define _POSIX_C_SOURCE 200809L
+
+#include <errno.h>
+#include <fcntl.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <sys/stat.h>
+#include <time.h>
+#include <unistd.h>
+
+#define REPLY_LEN 44 /* fingerprint + '\n' */
+
+static int connect_retry(const char *path) {
+    struct sockaddr_un addr;
+    memset(&addr, 0, sizeof addr);
+    addr.sun_family = AF_UNIX;
+    strncpy(addr.sun_path, path, sizeof addr.sun_path - 1);
+    for (int i = 0; i < 200; ++i) {
+        int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+        if (fd >= 0 && connect(fd, (struct sockaddr *)&addr, sizeof addr) == 0) return fd;
+        if (fd >= 0) close(fd);
+        struct timespec ts = {0, 10 * 1000 * 1000};
+        nanosleep(&ts, NULL);
+    }
+    return -1;
+}
+
+/* Send req, then read until `lines` newlines arrive. */
+static int roundtrip(int fd, const char *req, int lines, char *out, size_t cap) {
+    size_t len = strlen(req), got = 0;
+    if (write(fd, req, len) != (ssize_t)len) return -1;
+    while (lines > 0 && got + 1 < cap) {
+        ssize_t n = read(fd, out + got, cap - 1 - got);
+        if (n <= 0) return -1;
+        for (ssize_t i = 0; i < n; ++i) if (out[got + i] == '\n') lines--;
+        got += (size_t)n;
+    }
+    out[got] = '\0';
+    return 0;
+}
+
+static void set_addr(struct sockaddr_un *addr, const char *path) {
+    memset(addr, 0, sizeof *addr);
+    addr->sun_family = AF_UNIX;
+    strncpy(addr->sun_path, path, sizeof addr->sun_path - 1);
+}
+
+/* Leave a bound-but-closed socket at path, as a crashed daemon would. */
+static void make_stale_socket(const char *path) {
+    struct sockaddr_un addr;
+    set_addr(&addr, path);
+    int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+    if (fd >= 0) {
+        bind(fd, (struct sockaddr *)&addr, sizeof addr);
+        close(fd);
+    }
+}
+
+/* utime + stime of pid in clock ticks, or -1. */
+static long cpu_ticks(pid_t pid) {
+    char path[64], buf[1024];
+    snprintf(path, sizeof path, "/proc/%ld/stat", (long)pid);
+    FILE *f = fopen(path, "r");
+    if (!f) return -1;
+    size_t n = fread(buf, 1, sizeof buf - 1, f);
+    fclose(f);
+    buf[n] = '\0';
+    char *p = strrchr(buf, ')');
+    unsigned long ut = 0, st = 0;
+    /* fields after the command: state ppid pgrp session tty tpgid flags minflt cminflt majflt cmajflt utime stime */
+    if (!p || sscanf(p + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %lu %lu", &ut, &st) != 2) return -1;
+    return (long)(ut + st);
+}
+
+/* Write "GET\n" requests without reading until the socket stops accepting
+ * them (or limit bytes went out). Returns the number of complete requests
+ * sent; *blocked tells whether writes blocked before the limit. */
+static size_t flood(int fd, size_t limit, int *blocked) {
+    static char chunk[4096];
+    for (size_t i = 0; i < sizeof chunk; i += 4) memcpy(chunk + i, "GET\n", 4);
+    int flags = fcntl(fd, F_GETFL);
+    fcntl(fd, F_SETFL, flags | O_NONBLOCK);
+    size_t sent = 0;
+    *blocked = 0;
+    while (sent < limit) {
+        struct pollfd pfd = {fd, POLLOUT, 0};
+        if (poll(&pfd, 1, 500) == 0) { *blocked = 1; break; }
+        ssize_t n = write(fd, chunk, sizeof chunk - (sent % 4));
+        if (n < 0 && errno == EAGAIN) continue;
+        if (n <= 0) break;
+        sent += (size_t)n;
+    }
+    fcntl(fd, F_SETFL, flags);
+    /* Complete the trailing partial request so every sent line is answered */
+    if (sent % 4) {
+        size_t rest = 4 - sent % 4;
+        if (write(fd, "GET\n" + (sent % 4), rest) == (ssize_t)rest) sent += rest;
+    }
+    return sent / 4;
+}
+
+/* Read replies until eof; returns the byte count or -1 on a wrong reply. */
+static long drain(int fd, const char *want_line) {
+    char buf[8192];
+    long total = 0;
+    for (;;) {
+        ssize_t n = read(fd, buf, sizeof buf);
+        if (n == 0) return total;
+        if (n < 0) return -1;
+        for (ssize_t i = 0; i < n; ++i, ++total)
+            if (buf[i] != want_line[total % REPLY_LEN]) return -1;
+    }
+}
+
+/* Run a second --serve on path; returns its exit status (or -1). */
+static int serve_status(const char *exe, const char *path, const char *mid) {
+    pid_t pid = fork();
+    if (pid == 0) {
+        int devnull = open("/dev/null", O_WRONLY);
+        if (devnull >= 0) dup2(devnull, 2);
+        execl(exe, exe, "--serve", path, "--machine-id-file", mid, (char *)NULL);
+        _exit(127);
+    }
+    int status = 0;
+    waitpid(pid, &status, 0);
+    return WIFEXITED(status) ? WEXITSTATUS(status) : -1;
+}
+
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        fprintf(stderr, "usage: %s <oksi_fingerprint> <mid_file>\n", argv[0]);
+        return 2;
+    }
+    char sock[64];
+    snprintf(sock, sizeof sock, "/tmp/oksi_fp_test_%ld.sock", (long)getpid());
+    make_stale_socket(sock);
+
+    pid_t pid = fork();
+    if (pid == 0) {
+        execl(argv[1], argv[1], "--serve", sock, "--machine-id-file", argv[2], (char *)NULL);
+        _exit(127);
+    }
+
+    int failures = 0;
+    char buf[512];
+    const char *want =
+        "yTsFgAbUO-EC-QOPPPGqz0WhmfqWMbIZARKwKWF9ldw\n"
+        "OYGS4aIPb4PWsdsbF4c9GhkCp_6mFrugH7-4ufNR_-4\n"
+        "65wHlLMSzCOIJAX310spHpZj0hVpklt-UQY3fq6cBGA\n"
+        "OYGS4aIPb4PWsdsbF4c9GhkCp_6mFrugH7-4ufNR_-4\n"
+        "ERR bad request\n";
+
+    int fd = connect_retry(sock);
+    if (fd < 0 || roundtrip(fd, "GET\nGET s\nGET prod-42\r\nGET s\nPUT x\n", 5, buf, sizeof buf) != 0) {
+        fprintf(stderr, "FAIL pipelined: no response\n");
+        failures++;
+    } else if (strcmp(buf, want) != 0) {
+        fprintf(stderr, "FAIL pipelined: got\n%s", buf);
+        failures++;
+    }
+    if (fd >= 0) close(fd);
+
+    fd = connect_retry(sock);
+    if (fd < 0 || roundtrip(fd, "GET prod-42\n", 1, buf, sizeof buf) != 0 ||
+        strcmp(buf, "65wHlLMSzCOIJAX310spHpZj0hVpklt-UQY3fq6cBGA\n") != 0) {
+        fprintf(stderr, "FAIL second connection\n");
+        failures++;
+    }
+    if (fd >= 0) close(fd);
+
+    /* Backpressure: the daemon stops reading once replies pile up */
+    const char *no_salt = "yTsFgAbUO-EC-QOPPPGqz0WhmfqWMbIZARKwKWF9ldw\n";
+    fd = connect_retry(sock);
+    if (fd >= 0) {
+        int blocked = 0;
+        size_t sent = flood(fd, (size_t)256 << 20, &blocked);
+        if (!blocked) {
+            fprintf(stderr, "FAIL backpressure: daemon kept reading (%zu requests)\n", sent);
+            failures++;
+        }
+
+        /* Half-close with replies pending: the daemon must not spin */
+        shutdown(fd, SHUT_WR);
+        long before = cpu_ticks(pid);
+        struct timespec ts = {1, 0};
+        nanosleep(&ts, NULL);
+        long after = cpu_ticks(pid);
+        long ticks_per_s = sysconf(_SC_CLK_TCK);
+        if (before < 0 || after < 0 || after - before > ticks_per_s / 5) {
+            fprintf(stderr, "FAIL half-close: daemon used %ld ticks while idle\n", after - before);
+            failures++;
+        }
+
+        long got = drain(fd, no_salt);
+        if (got != (long)(sent * REPLY_LEN)) {
+            fprintf(stderr, "FAIL backpressure: %ld reply bytes for %zu requests\n", got, sent);
+            failures++;
+        }
+        close(fd);
+    } else {
+        fprintf(stderr, "FAIL backpressure: no connection\n");
+        failures++;
+    }
+
+    /* Existing paths: a live daemon's socket and a regular file are kept */
+    if (serve_status(argv[1], sock, argv[2]) != 1) {
+        fprintf(stderr, "FAIL live socket: second server did not refuse\n");
+        failures++;
+    }
+    fd = connect_retry(sock);
+    if (fd < 0 || roundtrip(fd, "GET\n", 1, buf, sizeof buf) != 0 || strcmp(buf, no_salt) != 0) {
+        fprintf(stderr, "FAIL live socket: first server no longer answers\n");
+        failures++;
+    }
+    if (fd >= 0) close(fd);
+    char file[64];
+    snprintf(file, sizeof file, "/tmp/oksi_fp_test_%ld.txt", (long)getpid());
+    FILE *f = fopen(file, "w");
+    if (f) fclose(f);
+    struct stat st;
+    if (serve_status(argv[1], file, argv[2]) != 1 || stat(file, &st) != 0 || !S_ISREG(st.st_mode)) {
+        fprintf(stderr, "FAIL regular file: --serve replaced it\n");
+        failures++;
+    }
+    unlink(file);
+
+    kill(pid, SIGTERM);
+    int status = 0;
+    waitpid(pid, &status, 0);
+    if (!WIFEXITED(status) || WEXITSTATUS(status) != 0) {
+        fprintf(stderr, "FAIL server exit status %d\n", status);
+        failures++;
+    }
+    if (access(sock, F_OK) == 0) {
+        fprintf(stderr, "FAIL socket not removed\n");
+        unlink(sock);
+        failures++;
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,116 @@
+// SHA256 clone/export/import and FingerprintPrefix tests.
+// Usage: oksi_sha256_state_test
+// Every forked or resumed hash must equal a one-shot hash of the same bytes,
+// and FingerprintPrefix::derive() must equal compute_fingerprint() for prefix
+// and salt lengths on both sides of the 64-byte block boundaries.
+
+#include "fingerprint_core.hpp"
+#include "sha256.hpp"
+
+#include <cstdio>
+#include <string>
+
+static int failures = 0;
+
+static void expect(const std::string &name, bool ok) {
+    if (!ok) {
+        std::fprintf(stderr, "FAIL %s\n", name.c_str());
+        failures++;
+    }
+}
+
+static std::array<uint8_t,32> one_shot(const std::string &s) {
+    oksi::SHA256 sha;
+    sha.update(s);
+    return sha.digest();
+}
+
+static std::string pattern(size_t n, char base) {
+    std::string s;
+    for (size_t i = 0; i < n; ++i) s.push_back(static_cast<char>(base + i % 26));
+    return s;
+}
+
+int main() {
+    if (const char *req = oksi::sha256_detail::unavailable_backend_request()) {
+        std::fprintf(stderr, "SKIP %s: backend not available on this CPU\n", req);
+        return oksi::sha256_detail::kBackendUnavailableExit;
+    }
+
+    const std::string prefix = pattern(200, 'a');
+    const std::string suffix = pattern(150, 'A');
+
+    // clone() at every split point forks an independent hash
+    for (size_t split = 0; split <= prefix.size(); ++split) {
+        oksi::SHA256 base;
+        base.update(prefix.substr(0, split));
+        oksi::SHA256 fork = base.clone();
+        fork.update(prefix.substr(split) + suffix);
+        base.update(prefix.substr(split));
+        expect("clone_" + std::to_string(split), fork.digest() == one_shot(prefix + suffix) &&
+                                                 base.digest() == one_shot(prefix));
+    }
+
+    // export/import only at block boundaries, also through the byte image
+    for (size_t split = 0; split <= prefix.size(); ++split) {
+        oksi::SHA256 base;
+        base.update(prefix.substr(0, split));
+        oksi::SHA256::Midstate st{};
+        const bool exported = base.export_state(st);
+        expect("export_" + std::to_string(split), exported == (split % 64 == 0) &&
+                                                  exported == base.at_block_boundary());
+        if (!exported) continue;
+
+        const auto image = st.to_bytes();
+        oksi::SHA256::Midstate parsed{};
+        oksi::SHA256 resumed;
+        resumed.update("discarded by import");
+        expect("from_bytes_" + std::to_string(split),
+               oksi::SHA256::Midstate::from_bytes(image.data(), image.size(), parsed) && parsed.length == split);
+        expect("import_" + std::to_string(split), resumed.import_state(parsed));
+        resumed.update(prefix.substr(split) + suffix);
+        expect("resume_" + std::to_string(split), resumed.digest() == one_shot(prefix + suffix));
+    }
+
+    // Malformed midstates are rejected
+    oksi::SHA256::Midstate bad{};
+    bad.length = 65;
+    oksi::SHA256 sha;
+    expect("import_unaligned", !sha.import_state(bad));
+    const auto image = bad.to_bytes();
+    expect("from_bytes_unaligned", !oksi::SHA256::Midstate::from_bytes(image.data(), image.size(), bad));
+    expect("from_bytes_short", !oksi::SHA256::Midstate::from_bytes(image.data(), image.size() - 1, bad));
+    bad.length = UINT64_MAX & ~uint64_t(63);
+    expect("import_too_long", !sha.import_state(bad));
+
+    // A rejected image leaves the destination untouched
+    oksi::SHA256::Midstate kept{};
+    for (size_t i = 0; i < 8; ++i) kept.state[i] = 0xa5a5a5a5u + uint32_t(i);
+    kept.length = 128;
+    const auto kept_bytes = kept.to_bytes();
+    oksi::SHA256::Midstate src{};
+    for (size_t i = 0; i < 8; ++i) src.state[i] = uint32_t(i);
+    for (uint64_t len : {uint64_t(65), UINT64_MAX & ~uint64_t(63)}) {
+        src.length = len;
+        const auto src_image = src.to_bytes();
+        oksi::SHA256::Midstate out = kept;
+        expect("from_bytes_untouched_" + std::to_string(len),
+               !oksi::SHA256::Midstate::from_bytes(src_image.data(), src_image.size(), out) &&
+               out.to_bytes() == kept_bytes);
+    }
+
+    // FingerprintPrefix matches compute_fingerprint byte for byte
+    for (size_t mid_len : {0, 1, 32, 52, 53, 58, 59, 64, 117, 200}) {
+        const std::string mid = pattern(mid_len, 'a');
+        const oksi::FingerprintPrefix fp(mid);
+        for (size_t salt_len = 0; salt_len <= 130; ++salt_len) {
+            const std::string salt = pattern(salt_len, 'A');
+            expect("prefix_" + std::to_string(mid_len) + "_" + std::to_string(salt_len),
+                   fp.derive(salt) == oksi::compute_fingerprint(mid, salt));
+        }
+    }
+    expect("prefix_vector", oksi::FingerprintPrefix("abcd").derive("prod-42") ==
+                                "65wHlLMSzCOIJAX310spHpZj0hVpklt-UQY3fq6cBGA");
+
+    return failures ? 1 : 0;
+}
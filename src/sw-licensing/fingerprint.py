@@ -1,10 +1,27 @@
 # fingerprint.py
 import base64
+import ctypes
+import ctypes.util
 import hashlib
+import os
 import pathlib
+import re
+import socket
 import subprocess
 import shutil
 
+# Length of an encoded fingerprint (OKSI_FINGERPRINT_LEN in oksi_fingerprint.h).
+_FP_LEN = 43
+
+# A well-formed fingerprint: unpadded base64url of a SHA-256 digest.
+_FP_RE = re.compile(r"[A-Za-z0-9_-]{%d}" % _FP_LEN)
+
+# Socket served by `oksi_fingerprint --serve`; override with OKSI_FINGERPRINT_SOCKET.
+_DEFAULT_SOCKET = "/run/oksi/fp.sock"
+
+# Cached handle to liboksi_fingerprint: None = not probed yet, False = unavailable.
+_cdll = None
+
 def _read_text(path: str) -> str:
     try:
         with open(path, "r", encoding="utf-8", errors="ignore") as f:
@@ -12,6 +29,96 @@ def _read_text(path: str) -> str:
     except Exception:
         return ""
 
+def _try_socket_fingerprint(extra_salt: str | None = None) -> str | None:
+    """
+    Ask a running fingerprint daemon (`oksi_fingerprint --serve`) over its
+    Unix domain socket. Returns the fingerprint string on success, or None if
+    no daemon is listening, the request failed or the reply is not a
+    well-formed fingerprint (so a stale or foreign listener on the socket
+    path cannot inject a value).
+    """
+    path = os.environ.get("OKSI_FINGERPRINT_SOCKET", _DEFAULT_SOCKET)
+    salt = str(extra_salt) if extra_salt else ""
+    if not hasattr(socket, "AF_UNIX") or "\n" in salt or "\r" in salt or not os.path.exists(path):
+        return None
+    req = (f"GET {salt}\n" if salt else "GET\n").encode("utf-8")
+    try:
+        with socket.socket(socket.AF_UNIX, socket.SOCK_STREAM) as s:
+            s.settimeout(0.5)
+            s.connect(path)
+            s.sendall(req)
+            buf = b""
+            while not buf.endswith(b"\n"):
+                chunk = s.recv(256)
+                if not chunk:
+                    return None
+                buf += chunk
+    except OSError:
+        return None
+    out = buf.decode("ascii", errors="replace").strip()
+    return out if _FP_RE.fullmatch(out) else None
+
+
+def _lib_candidates() -> list[str]:
+    """
+    Candidate locations for liboksi_fingerprint, in priority order:
+    OKSI_FINGERPRINT_LIB, next to this file, ../lib relative to an
+    oksi_fingerprint executable in PATH, then the system loader search path.
+    """
+    names = ["liboksi_fingerprint.so.1", "liboksi_fingerprint.so", "liboksi_fingerprint.dylib", "oksi_fingerprint.dll"]
+    here = pathlib.Path(__file__).parent
+    dirs = [here]
+    exe = shutil.which("oksi_fingerprint")
+    if exe:
+        dirs.append(pathlib.Path(exe).resolve().parent.parent / "lib")
+    candidates: list[str] = []
+    env = os.environ.get("OKSI_FINGERPRINT_LIB")
+    if env:
+        candidates.append(env)
+    candidates += [str(d / n) for d in dirs for n in names if (d / n).is_file()]
+    found = ctypes.util.find_library("oksi_fingerprint")
+    if found:
+        candidates.append(found)
+    return candidates
+
+
+def _load_lib():
+    """Load liboksi_fingerprint once; returns the CDLL or None if unavailable."""
+    global _cdll
+    if _cdll is None:
+        _cdll = False
+        for cand in _lib_candidates():
+            try:
+                lib = ctypes.CDLL(cand)
+                fn = lib.oksi_fingerprint
+            except (OSError, AttributeError):
+                continue
+            fn.argtypes = [ctypes.c_char_p, ctypes.c_char_p, ctypes.c_char_p, ctypes.c_size_t]
+            fn.restype = ctypes.c_int
+            _cdll = lib
+            break
+    return _cdll or None
+
+
+def _try_lib_fingerprint(extra_salt: str | None = None) -> str | None:
+    """
+    Try to compute the fingerprint in-process via liboksi_fingerprint (ctypes).
+    Returns the fingerprint string on success, or None if unavailable/failed.
+    """
+    lib = _load_lib()
+    if lib is None:
+        return None
+    buf = ctypes.create_string_buffer(_FP_LEN + 1)
+    salt = str(extra_salt).encode("utf-8") if extra_salt else None
+    try:
+        rc = lib.oksi_fingerprint(salt, None, buf, len(buf))
+    except Exception:
+        return None
+    if rc != 0:
+        return None
+    return buf.value.decode("ascii") or None
+
+
 def _try_cpp_fingerprint(extra_salt: str | None = None) -> str | None:
     """
     Try to compute the fingerprint using the compiled C++ helper if available.
@@ -51,8 +158,11 @@ def generate_fingerprint(extra_salt: str | None = None) -> str:
 
     Output: URL-safe base64 of SHA-256 digest.
     """
-    # Prefer the C++ implementation if present
-    cpp = _try_cpp_fingerprint(extra_salt)
+    # Prefer the fingerprint daemon, then the in-process C++ library, then the
+    # C++ helper executable
+    cpp = (_try_socket_fingerprint(extra_salt)
+           or _try_lib_fingerprint(extra_salt)
+           or _try_cpp_fingerprint(extra_salt))
     if cpp:
         return cpp
 